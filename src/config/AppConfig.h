@@ -41,7 +41,8 @@ struct WatchdogImpl {
 
 // Timing configuration
 struct TimingImpl {
-    static constexpr uint32_t kScreenTaskMs = 33;
+    static constexpr uint32_t kScreenPollMs = 33;        // Screens and touch without wakeups
+    static constexpr uint32_t kScreenMaxSleepMs = 1000;  // Keeps the watchdog fed
     static constexpr uint32_t kBackgroundTaskMs = 20;
     static constexpr uint32_t kMainLoopMs = 10;
 };
@@ -50,16 +51,34 @@ struct TimingImpl {
 struct TasksImpl {
     static constexpr uint32_t kScreenStack = 4096;
     static constexpr uint32_t kBackgroundStack = 8096;
+    static constexpr uint32_t kParseStack = 8096;
     static constexpr uint32_t kScreenPriority = 2;
     static constexpr uint32_t kBackgroundPriority = 1;
+    static constexpr uint32_t kParsePriority = 1;
 };
 
 // HardwareMonitor configuration
 struct HardwareMonitorImpl {
     static constexpr uint32_t kRefreshMs = 500;
     static constexpr uint32_t kRefreshAfterFailureMs = 3000;
+    static constexpr uint32_t kMinRefreshMs = 250;      // Floor while load moves fast
+    static constexpr uint32_t kStaticRefreshMs = 2000;  // Ceiling while values are static
+    static constexpr uint32_t kMaxFailureBackoffMs = 30000;
+    static constexpr uint16_t kFailureJitterMs = 500;
+    static constexpr uint8_t kFastChangeDelta = 10;  // Load step (%) that counts as fast
+    static constexpr uint32_t kPhaseGuardMs = 50;    // Poll this long after the host update
+    static constexpr uint32_t kPhaseStepMs = 10;     // Phase probe step per poll
     static constexpr uint32_t kRetryDelayMs = 200;
     static constexpr uint32_t kMaxRetries = 2;
+    static constexpr uint32_t kFetchBudgetMs = 4000;  // Whole fetch, retries included
+    static constexpr bool kStreamParse = true;  // Parse straight from the socket (not pipelined)
+    static constexpr uint32_t kModeCompareInterval = 16;  // Every Nth poll the other mode, 0 off
+    static constexpr bool kKeepAlive = true;    // Reuse the TCP connection between polls
+    static constexpr bool kUseLhmScanner = false;  // LhmScanner instead of ArduinoJson
+    static constexpr bool kPipelined = false;      // Fetch and parse on separate tasks
+    static constexpr uint32_t kPushTimeoutMs = 3000;  // Polling stays off this long after a push
+    static constexpr bool kAcceptMsgPack = true;      // Offer MessagePack, JSON still understood
+    static constexpr uint32_t kJsonArenaBytes = 48 * 1024;  // PSRAM per parser, 0 for the heap
 };
 
 // Metrics configuration
@@ -69,7 +88,7 @@ struct MetricsImpl {
 
 // PcMetrics configuration
 struct PcMetricsImpl {
-    static constexpr uint8_t kCores = 18;
+    static constexpr uint8_t kMaxHosts = 4;  // LIBRE_HM_API plus extra hosts
 };
 
 // UI configuration
@@ -77,6 +96,11 @@ struct UiImpl {
     static constexpr uint32_t kTransitionTimeoutMs = 1000;
     static constexpr uint32_t kTouchDebounceIntervalMs = 200;
     static constexpr uint32_t kDisplayLockTimeoutMs = 200;
+    static constexpr uint32_t kWidgetSpriteBytes = 192 * 1024;  // PSRAM per widget, 0 draws direct
+    static constexpr uint32_t kSpritePsramReserveBytes = 512 * 1024;  // Kept free of sprites
+    static constexpr uint8_t kDmaBufferCount = 2;  // Staging buffers, under 2 pushes synchronously
+    static constexpr uint32_t kDmaBufferBytes = 16 * 1024;  // Internal DMA RAM each
+    static constexpr bool kUseGlyphAtlas = true;  // Number text blitted, off for the font engine
 };
 }  // namespace internal
 
@@ -23,7 +23,8 @@ class AppConfigInterface {
     virtual bool getWatchdogEnableOnBoot() const = 0;
 
     // Timing getters
-    virtual uint32_t getTimingScreenTaskMs() const = 0;
+    virtual uint32_t getTimingScreenPollMs() const = 0;
+    virtual uint32_t getTimingScreenMaxSleepMs() const = 0;
     virtual uint32_t getTimingBackgroundTaskMs() const = 0;
     virtual uint32_t getTimingMainLoopMs() const = 0;
 
@@ -32,21 +33,44 @@ class AppConfigInterface {
     virtual uint32_t getTasksBackgroundStack() const = 0;
     virtual uint32_t getTasksScreenPriority() const = 0;
     virtual uint32_t getTasksBackgroundPriority() const = 0;
+    virtual uint32_t getTasksParseStack() const = 0;
+    virtual uint32_t getTasksParsePriority() const = 0;
 
     // HardwareMonitor getters
     virtual uint32_t getHardwareMonitorRefreshMs() const = 0;
     virtual uint32_t getHardwareMonitorFailureRefreshMs() const = 0;
+    virtual uint32_t getHardwareMonitorMinRefreshMs() const = 0;
+    virtual uint32_t getHardwareMonitorStaticRefreshMs() const = 0;
+    virtual uint32_t getHardwareMonitorMaxFailureBackoffMs() const = 0;
+    virtual uint16_t getHardwareMonitorFailureJitterMs() const = 0;
+    virtual uint8_t getHardwareMonitorFastChangeDelta() const = 0;
+    virtual uint32_t getHardwareMonitorPhaseGuardMs() const = 0;
+    virtual uint32_t getHardwareMonitorPhaseStepMs() const = 0;
     virtual uint32_t getHardwareMonitorRetryDelayMs() const = 0;
     virtual uint32_t getHardwareMonitorMaxRetries() const = 0;
+    virtual uint32_t getHardwareMonitorFetchBudgetMs() const = 0;
+    virtual bool getHardwareMonitorStreamParse() const = 0;
+    virtual uint32_t getHardwareMonitorModeCompareInterval() const = 0;
+    virtual bool getHardwareMonitorKeepAlive() const = 0;
+    virtual bool getHardwareMonitorUseLhmScanner() const = 0;
+    virtual bool getHardwareMonitorPipelined() const = 0;
+    virtual uint32_t getHardwareMonitorPushTimeoutMs() const = 0;
+    virtual bool getHardwareMonitorAcceptMsgPack() const = 0;
+    virtual uint32_t getHardwareMonitorJsonArenaBytes() const = 0;
 
     // Metrics getters
     virtual uint8_t getMetricsMaxScreenDrawTimes() const = 0;
 
     // PcMetrics getters
-    virtual uint8_t getPcMetricsCores() const = 0;
+    virtual uint8_t getPcMetricsMaxHosts() const = 0;
 
     // UI getters
     virtual uint32_t getUiTransitionTimeoutMs() const = 0;
     virtual uint32_t getUiTouchDebounceIntervalMs() const = 0;
     virtual uint32_t getUiDisplayLockTimeoutMs() const = 0;
+    virtual uint32_t getUiWidgetSpriteBytes() const = 0;
+    virtual uint32_t getUiSpritePsramReserveBytes() const = 0;
+    virtual uint8_t getUiDmaBufferCount() const = 0;
+    virtual uint32_t getUiDmaBufferBytes() const = 0;
+    virtual bool getUiUseGlyphAtlas() const = 0;
 };
\ No newline at end of file
@@ -49,8 +49,12 @@ class AppConfigService : public AppConfigInterface {
     }
 
     // Timing getters
-    uint32_t getTimingScreenTaskMs() const override {
-        return AppConfig::internal::TimingImpl::kScreenTaskMs;
+    uint32_t getTimingScreenPollMs() const override {
+        return AppConfig::internal::TimingImpl::kScreenPollMs;
+    }
+
+    uint32_t getTimingScreenMaxSleepMs() const override {
+        return AppConfig::internal::TimingImpl::kScreenMaxSleepMs;
     }
 
     uint32_t getTimingBackgroundTaskMs() const override {
@@ -78,6 +82,14 @@ class AppConfigService : public AppConfigInterface {
         return AppConfig::internal::TasksImpl::kBackgroundPriority;
     }
 
+    uint32_t getTasksParseStack() const override {
+        return AppConfig::internal::TasksImpl::kParseStack;
+    }
+
+    uint32_t getTasksParsePriority() const override {
+        return AppConfig::internal::TasksImpl::kParsePriority;
+    }
+
     // HardwareMonitor getters - MATCHING NAMES
     uint32_t getHardwareMonitorRefreshMs() const override {
         return AppConfig::internal::HardwareMonitorImpl::kRefreshMs;
@@ -87,6 +99,34 @@ class AppConfigService : public AppConfigInterface {
         return AppConfig::internal::HardwareMonitorImpl::kRefreshAfterFailureMs;
     }
 
+    uint32_t getHardwareMonitorMinRefreshMs() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kMinRefreshMs;
+    }
+
+    uint32_t getHardwareMonitorStaticRefreshMs() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kStaticRefreshMs;
+    }
+
+    uint32_t getHardwareMonitorMaxFailureBackoffMs() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kMaxFailureBackoffMs;
+    }
+
+    uint16_t getHardwareMonitorFailureJitterMs() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kFailureJitterMs;
+    }
+
+    uint8_t getHardwareMonitorFastChangeDelta() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kFastChangeDelta;
+    }
+
+    uint32_t getHardwareMonitorPhaseGuardMs() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kPhaseGuardMs;
+    }
+
+    uint32_t getHardwareMonitorPhaseStepMs() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kPhaseStepMs;
+    }
+
     uint32_t getHardwareMonitorRetryDelayMs() const override {
         return AppConfig::internal::HardwareMonitorImpl::kRetryDelayMs;
     }
@@ -95,14 +135,50 @@ class AppConfigService : public AppConfigInterface {
         return AppConfig::internal::HardwareMonitorImpl::kMaxRetries;
     }
 
+    uint32_t getHardwareMonitorFetchBudgetMs() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kFetchBudgetMs;
+    }
+
+    bool getHardwareMonitorStreamParse() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kStreamParse;
+    }
+
+    uint32_t getHardwareMonitorModeCompareInterval() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kModeCompareInterval;
+    }
+
+    bool getHardwareMonitorKeepAlive() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kKeepAlive;
+    }
+
+    bool getHardwareMonitorUseLhmScanner() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kUseLhmScanner;
+    }
+
+    bool getHardwareMonitorPipelined() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kPipelined;
+    }
+
+    uint32_t getHardwareMonitorPushTimeoutMs() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kPushTimeoutMs;
+    }
+
+    bool getHardwareMonitorAcceptMsgPack() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kAcceptMsgPack;
+    }
+
+    uint32_t getHardwareMonitorJsonArenaBytes() const override {
+        return AppConfig::internal::HardwareMonitorImpl::kJsonArenaBytes;
+    }
+
     // Metrics getters - MATCHING NAMES
     uint8_t getMetricsMaxScreenDrawTimes() const override {
         return AppConfig::internal::MetricsImpl::kMaxScreenDrawTimes;
     }
 
     // PcMetrics getters
-    uint8_t getPcMetricsCores() const override {
-        return AppConfig::internal::PcMetricsImpl::kCores;
+    uint8_t getPcMetricsMaxHosts() const override {
+        return AppConfig::internal::PcMetricsImpl::kMaxHosts;
     }
 
     // UI getters
@@ -117,4 +193,24 @@ class AppConfigService : public AppConfigInterface {
     uint32_t getUiDisplayLockTimeoutMs() const override {
         return AppConfig::internal::UiImpl::kDisplayLockTimeoutMs;
     }
+
+    uint32_t getUiWidgetSpriteBytes() const override {
+        return AppConfig::internal::UiImpl::kWidgetSpriteBytes;
+    }
+
+    uint32_t getUiSpritePsramReserveBytes() const override {
+        return AppConfig::internal::UiImpl::kSpritePsramReserveBytes;
+    }
+
+    uint8_t getUiDmaBufferCount() const override {
+        return AppConfig::internal::UiImpl::kDmaBufferCount;
+    }
+
+    uint32_t getUiDmaBufferBytes() const override {
+        return AppConfig::internal::UiImpl::kDmaBufferBytes;
+    }
+
+    bool getUiUseGlyphAtlas() const override {
+        return AppConfig::internal::UiImpl::kUseGlyphAtlas;
+    }
 };
\ No newline at end of file
@@ -5,6 +5,28 @@
 #define TFT_WIDTH 320
 #define TFT_HEIGHT 480
 
+#ifdef NATIVE_BUILD
+
+// Native build: the panel is an SDL window, the mouse acts as the touch screen
+class LGFX : public lgfx::LGFX_Device {
+    lgfx::Panel_sdl _panel_instance;
+
+ public:
+    LGFX(void) {
+        auto cfg = _panel_instance.config();
+        cfg.memory_width = TFT_WIDTH;
+        cfg.memory_height = TFT_HEIGHT;
+        cfg.panel_width = TFT_WIDTH;
+        cfg.panel_height = TFT_HEIGHT;
+        _panel_instance.config(cfg);
+        _panel_instance.setWindowTitle("NerdBox");
+
+        setPanel(&_panel_instance);
+    }
+};
+
+#else
+
 class LGFX : public lgfx::LGFX_Device {
     lgfx::Panel_ST7796 _panel_instance;  // ST7796UI
     lgfx::Bus_Parallel8 _bus_instance;   // MCU8080 8B
@@ -92,4 +114,6 @@ class LGFX : public lgfx::LGFX_Device {
 
         setPanel(&_panel_instance);
     }
-};
\ No newline at end of file
+};
+
+#endif  // NATIVE_BUILD
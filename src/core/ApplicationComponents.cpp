@@ -4,13 +4,16 @@ ApplicationComponents::ApplicationComponents()
     : webServer(80),
       logger(systemState.core.isTimeSynced),
       systemMetrics(config),
-      displayContext(display, colors, logger),
+      glyphs(display, config.getUiUseGlyphAtlas()),
+      displayContext(display, colors, glyphs, logger),
       networkManager(logger, httpClient, config),
       displayManager(display, logger),
-      pcMetricsService(networkManager, systemMetrics, logger, config),
-      uiController(displayContext, &displayManager, systemMetrics, systemState.pcMetrics,
+      pcMetricsHosts(systemState.pcMetrics, config),
+      pcMetricsPush(pcMetricsHosts, systemMetrics, logger, config),
+      pcMetricsService(httpClient, pcMetricsHosts.getUrl(0), systemMetrics, logger, config),
+      uiController(displayContext, &displayManager, systemMetrics, pcMetricsHosts,
                    systemState.screen, config),
-      webServerService(uiController, systemMetrics),
-      taskManager(logger, uiController, pcMetricsService, systemState.pcMetrics, systemState.core,
-                  systemState.screen, config),
+      webServerService(uiController, systemMetrics, pcMetricsHosts, pcMetricsPush),
+      taskManager(logger, uiController, systemMetrics, pcMetricsService, pcMetricsHosts,
+                  pcMetricsPush, systemState.core, systemState.screen, config),
       initStateMachine(*this) {}
\ No newline at end of file
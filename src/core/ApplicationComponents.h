@@ -14,11 +14,14 @@
 #include "network/HttpClient.h"
 #include "network/NetworkManager.h"
 #include "services/NtpService.h"
+#include "services/pcMetrics/PcMetricsHosts.h"
+#include "services/pcMetrics/PcMetricsPushReceiver.h"
 #include "services/pcMetrics/PcMetricsService.h"
 #include "services/WebServerService.h"
 #include "ui/Colors.h"
 #include "ui/DisplayManager.h"
-#include "ui/UiController.h"
+#include "ui/GlyphAtlas.h"
+#include "ui/UIController.h"
 #include "utils/ApplicationMetrics.h"
 #include "utils/Logger.h"
 
@@ -36,12 +39,15 @@ class ApplicationComponents {
     // Core configuration and state
     AppConfigService config;
     SystemState systemState;
+    PcMetricsHosts pcMetricsHosts;
+    PcMetricsPushReceiver pcMetricsPush;
 
     // Hardware
     LGFX display;
 
     // UI Components
     Colors colors;
+    GlyphAtlas glyphs;
     DisplayContext displayContext;
     DisplayManager displayManager;
     UiController uiController;
@@ -1,18 +1,26 @@
 #include "TaskManager.h"
 
 #include <esp_task_wdt.h>
+#include <WiFi.h>
+
+#include <algorithm>
 
 TaskManager::TaskManager(LoggerInterface& logger, UiController& uiController,
-                         PcMetricsService& pcMetricsService, PcMetrics& pcMetrics,
+                         ApplicationMetrics& systemMetrics, PcMetricsService& pcMetricsService,
+                         PcMetricsHosts& pcMetricsHosts, PcMetricsPushReceiver& pushReceiver,
                          SystemState::CoreState& coreState, SystemState::ScreenState& screenState,
                          AppConfigInterface& config)
     : logger_(logger),
       uiController_(uiController),
+      systemMetrics_(systemMetrics),
       pcMetricsService_(pcMetricsService),
-      pcMetrics_(pcMetrics),
+      pcMetricsHosts_(pcMetricsHosts),
+      pcMetrics_(pcMetricsHosts.getSnapshot(0)),
+      pushReceiver_(pushReceiver),
       coreState_(coreState),
       screenState_(screenState),
-      config_(config) {}
+      config_(config),
+      pollScheduler_(config) {}
 
 bool TaskManager::createTasks() {
     logger_.info("Initializing Application Tasks", true);
@@ -25,6 +33,10 @@ bool TaskManager::createTasks() {
         logger_.critical("Failed to create screen update task", true);
         return false;
     }
+    uiController_.setScreenTask(screenTaskHandle_);
+    for (uint8_t host = 0; host < pcMetricsHosts_.count(); host++) {
+        pcMetricsHosts_.getSnapshot(host).setSubscriber(screenTaskHandle_);
+    }
 
     success = createTask(backgroundTask, BACKGROUND_TASK_NAME, config_.getTasksBackgroundStack(),
                          config_.getTasksBackgroundPriority(), &backgroundTaskHandle_,
@@ -36,6 +48,25 @@ bool TaskManager::createTasks() {
         return false;
     }
 
+    if (config_.getHardwareMonitorPipelined()) {
+        success = pipeline_.begin() &&
+                  createTask(parseTask, PARSE_TASK_NAME, config_.getTasksParseStack(),
+                             config_.getTasksParsePriority(), &parseTaskHandle_,
+                             ARDUINO_RUNNING_CORE);
+
+        if (!success) {
+            logger_.critical("Failed to create parse task", true);
+            cleanup();
+            return false;
+        }
+    }
+
+    if (!createHostPollTasks()) {
+        logger_.critical("Failed to create host poll tasks", true);
+        cleanup();
+        return false;
+    }
+
     if (config_.getWatchdogEnableOnBoot()) {
         initializeWatchdog();
     }
@@ -45,6 +76,12 @@ bool TaskManager::createTasks() {
 }
 
 void TaskManager::cleanup() {
+    // Nothing may notify the screen task once it is gone
+    uiController_.setScreenTask(nullptr);
+    for (uint8_t host = 0; host < pcMetricsHosts_.count(); host++) {
+        pcMetricsHosts_.getSnapshot(host).setSubscriber(nullptr);
+    }
+
     if (screenTaskHandle_ != nullptr) {
         vTaskDelete(screenTaskHandle_);
         screenTaskHandle_ = nullptr;
@@ -54,12 +91,47 @@ void TaskManager::cleanup() {
         vTaskDelete(backgroundTaskHandle_);
         backgroundTaskHandle_ = nullptr;
     }
+
+    if (parseTaskHandle_ != nullptr) {
+        vTaskDelete(parseTaskHandle_);
+        parseTaskHandle_ = nullptr;
+    }
+
+    for (auto& task : hostPollTasks_) {
+        if (task->handle != nullptr) {
+            vTaskDelete(task->handle);
+        }
+    }
+    hostPollTasks_.clear();
+}
+
+bool TaskManager::createHostPollTasks() {
+    for (uint8_t host = 1; host < pcMetricsHosts_.count(); host++) {
+        auto task = std::make_unique<HostPollTask>();
+        task->manager = this;
+        task->host = host;
+        task->poller = std::make_unique<PcMetricsHostPoller>(host, pcMetricsHosts_, systemMetrics_,
+                                                             logger_, config_);
+        snprintf(task->name, sizeof(task->name), "%s%u", HOST_POLL_TASK_NAME, host);
+
+        HostPollTask* param = task.get();
+        hostPollTasks_.push_back(std::move(task));
+
+        if (!createTask(hostPollTask, param->name, config_.getTasksBackgroundStack(),
+                        config_.getTasksBackgroundPriority(), &param->handle, 0,  // Core 0
+                        param)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool TaskManager::createTask(TaskFunction_t taskFunction, const char* taskName, uint32_t stackSize,
-                             UBaseType_t priority, TaskHandle_t* taskHandle, BaseType_t coreId) {
-    BaseType_t status = xTaskCreatePinnedToCore(taskFunction, taskName, stackSize, this, priority,
-                                                taskHandle, coreId);
+                             UBaseType_t priority, TaskHandle_t* taskHandle, BaseType_t coreId,
+                             void* parameter) {
+    void* taskParameter = parameter != nullptr ? parameter : this;
+    BaseType_t status = xTaskCreatePinnedToCore(taskFunction, taskName, stackSize, taskParameter,
+                                                priority, taskHandle, coreId);
 
     if (status != pdPASS) {
         // Use the formatted version for including error code
@@ -78,6 +150,12 @@ void TaskManager::initializeWatchdog() {
     if (backgroundTaskHandle_ != nullptr) {
         esp_task_wdt_add(backgroundTaskHandle_);
     }
+    if (parseTaskHandle_ != nullptr) {
+        esp_task_wdt_add(parseTaskHandle_);
+    }
+    for (auto& task : hostPollTasks_) {
+        esp_task_wdt_add(task->handle);
+    }
     logger_.debug("Watchdog initialized for tasks", true);
 }
 
@@ -91,15 +169,27 @@ void TaskManager::backgroundTask(void* parameter) {
     taskManager->executeBackgroundTask();
 }
 
+void TaskManager::parseTask(void* parameter) {
+    auto* taskManager = static_cast<TaskManager*>(parameter);
+    taskManager->executeParseTask();
+}
+
+void TaskManager::hostPollTask(void* parameter) {
+    auto* task = static_cast<HostPollTask*>(parameter);
+    task->manager->executeHostPollTask(*task);
+}
+
 void TaskManager::executeScreenTask() {
-    const TickType_t frequency = pdMS_TO_TICKS(config_.getTimingScreenTaskMs());
-    TickType_t lastWakeTime = xTaskGetTickCount();
+    const uint32_t pollMs = config_.getTimingScreenPollMs();
+    const uint32_t maxSleepMs = config_.getTimingScreenMaxSleepMs();
     unsigned long lastStackLogTime = 0;
 
     while (true) {
+        uint32_t sleepMs = pollMs;
         if (screenState_.isInitialized) {
             uiController_.updateDisplay();
             resetWatchdog();
+            sleepMs = std::min(uiController_.msUntilUpdate(), maxSleepMs);
         }
 
         // Periodic stack monitoring
@@ -108,7 +198,13 @@ void TaskManager::executeScreenTask() {
             lastStackLogTime = millis();
         }
 
-        vTaskDelayUntil(&lastWakeTime, frequency);
+        // Sleep until a new sample, a touch, a screen request or the earliest widget
+        // deadline; at least a tick, so work that is due again right away cannot starve others
+        TickType_t ticks = std::max<TickType_t>(pdMS_TO_TICKS(sleepMs), 1);
+        bool notified = ulTaskNotifyTake(pdTRUE, ticks) > 0;
+        if (screenState_.isInitialized) {
+            systemMetrics_.addScreenWakeup(notified);
+        }
     }
 }
 
@@ -117,12 +213,27 @@ void TaskManager::executeBackgroundTask() {
     unsigned long lastStackLogTime = 0;
 
     while (true) {
+        // Parse outcomes, the schedule is only touched by this task
+        PcMetricsPipeline::Result result;
+        while (parseTaskHandle_ != nullptr && pipeline_.takeResult(result)) {
+            if (result.success) {
+                pcMetrics_.read(scheduledMetrics_);
+            }
+            completePcMetricsUpdate(result.success, result.polledAtMs, result.fetchTimeMs,
+                                    scheduledMetrics_);
+        }
+
         if (coreState_.isInitialized && WiFi.status() == WL_CONNECTED) {
-            if (screenState_.activeScreen == ScreenName::MAIN) {
-                if (millis() >= coreState_.nextSync_pcMetrics) {
+            updatePollingState();
+            // The PC pushing its own metrics makes polling redundant
+            if (pollingActive_ && millis() >= coreState_.nextSync_pcMetrics &&
+                !pushReceiver_.isPushActive(0)) {
+                if (parseTaskHandle_ != nullptr) {
+                    fetchPcMetrics();
+                } else {
                     updatePcMetrics();
-                    resetWatchdog();
                 }
+                resetWatchdog();
             }
         }
 
@@ -136,22 +247,133 @@ void TaskManager::executeBackgroundTask() {
     }
 }
 
+void TaskManager::executeParseTask() {
+    const TickType_t receiveTimeout = pdMS_TO_TICKS(PARSE_RECEIVE_TIMEOUT_MS);
+    unsigned long lastStackLogTime = 0;
+
+    while (true) {
+        PcMetricsPipeline::Sample* sample = pipeline_.receive(receiveTimeout);
+        if (sample != nullptr) {
+            parsePcMetrics(*sample);
+            pipeline_.release(sample);
+        }
+        resetWatchdog();
+
+        // Periodic stack monitoring
+        if (millis() - lastStackLogTime >= STACK_MONITOR_INTERVAL_MS) {
+            logStackHighWaterMark(PARSE_TASK_NAME);
+            lastStackLogTime = millis();
+        }
+    }
+}
+
+void TaskManager::executeHostPollTask(HostPollTask& task) {
+    const TickType_t frequency = pdMS_TO_TICKS(config_.getTimingBackgroundTaskMs());
+    PcMetricsHostPoller& poller = *task.poller;
+    bool wasActive = false;
+    unsigned long lastStackLogTime = 0;
+
+    while (true) {
+        // Follows the host 0 polling state, which the background task keeps up to date
+        bool active = pollingActive_ && coreState_.isInitialized && WiFi.status() == WL_CONNECTED;
+        if (active && !wasActive) {
+            poller.resume(millis());
+        }
+        wasActive = active;
+
+        if (active && poller.isDue(millis()) && !pushReceiver_.isPushActive(task.host)) {
+            poller.poll();
+        }
+        resetWatchdog();
+
+        // Periodic stack monitoring
+        if (millis() - lastStackLogTime >= STACK_MONITOR_INTERVAL_MS) {
+            logStackHighWaterMark(task.name);
+            lastStackLogTime = millis();
+        }
+
+        vTaskDelay(frequency);
+    }
+}
+
 void TaskManager::logStackHighWaterMark(const char* taskName) {
     UBaseType_t stackHighWaterMark = uxTaskGetStackHighWaterMark(nullptr);
     // Use the formatted version for including the number
     logger_.debugf("%s stack high water mark: %u", taskName, stackHighWaterMark);
 }
 
+void TaskManager::updatePollingState() {
+    bool metricsVisible = screenState_.activeScreen == ScreenName::MAIN;
+    if (metricsVisible == pollingActive_) {
+        return;
+    }
+
+    pollingActive_ = metricsVisible;
+    if (metricsVisible) {
+        // Prefetch right away so the screen does not wait a full interval
+        pollScheduler_.reset();
+        coreState_.nextSync_pcMetrics = millis();
+        logger_.debug("PC metrics polling resumed", true);
+    } else {
+        logger_.debug("PC metrics polling paused", true);
+    }
+}
+
 void TaskManager::updatePcMetrics() {
-    bool fetchSuccess = pcMetricsService_.fetchData(pcMetrics_);
+    unsigned long startMs = millis();
+    bool fetchSuccess = pcMetricsService_.fetchData(workingMetrics_);
+    unsigned long polledAtMs = millis();
+    pcMetrics_.publish(workingMetrics_);
+    completePcMetricsUpdate(fetchSuccess, polledAtMs, polledAtMs - startMs, workingMetrics_);
+}
+
+void TaskManager::fetchPcMetrics() {
+    PcMetricsPipeline::Sample* sample = pipeline_.acquire(0);
+    if (sample == nullptr) {
+        return;  // Every buffer is in flight, try again on the next tick
+    }
+
+    sample->fetchStartMs = millis();
+    sample->fetched = pcMetricsService_.fetchRaw(sample->body, sample->fetchHeapPeak);
+    sample->fetchedMs = millis();
+
+    // Provisional, the parse stage replaces it once the sample has been parsed
+    coreState_.nextSync_pcMetrics = sample->fetchStartMs + pollScheduler_.getIntervalMs();
+    pipeline_.submit(sample);
+}
+
+void TaskManager::parsePcMetrics(const PcMetricsPipeline::Sample& sample) {
+    bool success = false;
+    if (sample.fetched) {
+        success =
+            pcMetricsService_.parseRaw(sample.body, sample.fetchHeapPeak, workingMetrics_);
+    } else {
+        workingMetrics_.is_available = false;
+    }
+    pcMetrics_.publish(workingMetrics_);
+
+    systemMetrics_.setPcMetricsPipeline(millis() - sample.fetchStartMs,
+                                        pipeline_.getDroppedCount());
+    // The background task owns the schedule and finishes the update
+    pipeline_.report({success, sample.fetchedMs,
+                      static_cast<uint32_t>(sample.fetchedMs - sample.fetchStartMs)});
+}
+
+void TaskManager::completePcMetricsUpdate(bool success, unsigned long polledAtMs,
+                                          uint32_t fetchTimeMs, const PcMetrics& sample) {
+    systemMetrics_.addPcMetricsHostPoll(0, fetchTimeMs, success);
 
-    if (fetchSuccess) {
+    if (success) {
         consecutiveFailures_ = 0;
-        coreState_.nextSync_pcMetrics = millis() + config_.getHardwareMonitorRefreshMs();
+        coreState_.nextSync_pcMetrics =
+            polledAtMs + pollScheduler_.onSuccess(sample, polledAtMs);
+        systemMetrics_.setPcMetricsHostTiming(
+            pollScheduler_.isPhaseLocked(), pollScheduler_.getHostPeriodMs(),
+            pollScheduler_.getHostPhaseMs(), pollScheduler_.getLastDataAgeMs());
         logger_.debug("PC metrics updated successfully", true);
     } else {
         consecutiveFailures_++;
-        coreState_.nextSync_pcMetrics = millis() + config_.getHardwareMonitorFailureRefreshMs();
+        coreState_.nextSync_pcMetrics = polledAtMs + pollScheduler_.onFailure();
         handlePcMetricsFailure();
     }
 }
@@ -2,17 +2,27 @@
 
 #include <Arduino.h>
 
+#include <atomic>
+
 #include "config/AppConfigInterface.h"
 #include "core/state/SystemState.h"
 #include "services/pcMetrics/PcMetrics.h"
+#include "services/pcMetrics/PcMetricsHostPoller.h"
+#include "services/pcMetrics/PcMetricsHosts.h"
+#include "services/pcMetrics/PcMetricsPipeline.h"
+#include "services/pcMetrics/PcMetricsPushReceiver.h"
+#include "services/pcMetrics/PcMetricsSnapshot.h"
 #include "services/pcMetrics/PcMetricsService.h"
-#include "ui/UiController.h"
+#include "services/pcMetrics/PollScheduler.h"
+#include "ui/UIController.h"
+#include "utils/ApplicationMetrics.h"
 #include "utils/Logger.h"
 
 class TaskManager {
  public:
     TaskManager(LoggerInterface& logger, UiController& uiController,
-                PcMetricsService& pcMetricsService, PcMetrics& pcMetrics,
+                ApplicationMetrics& systemMetrics, PcMetricsService& pcMetricsService,
+                PcMetricsHosts& pcMetricsHosts, PcMetricsPushReceiver& pushReceiver,
                 SystemState::CoreState& coreState, SystemState::ScreenState& screenState,
                 AppConfigInterface& config);
 
@@ -22,18 +32,26 @@ class TaskManager {
     // Task entry points (keep these public and static for FreeRTOS)
     static void updateScreenTask(void* parameter);
     static void backgroundTask(void* parameter);
+    static void parseTask(void* parameter);
+    static void hostPollTask(void* parameter);
 
  private:
     // Constants
     static constexpr const char* SCREEN_TASK_NAME = "ScreenUpdate";
     static constexpr const char* BACKGROUND_TASK_NAME = "BackgroundTask";
+    static constexpr const char* PARSE_TASK_NAME = "ParseTask";
+    static constexpr const char* HOST_POLL_TASK_NAME = "HostPollTask";
+    static constexpr uint32_t PARSE_RECEIVE_TIMEOUT_MS = 1000;  // Well under the watchdog
     static constexpr unsigned long STACK_MONITOR_INTERVAL_MS = 20000;
 
     // Dependencies
     LoggerInterface& logger_;
     UiController& uiController_;
+    ApplicationMetrics& systemMetrics_;
     PcMetricsService& pcMetricsService_;
-    PcMetrics& pcMetrics_;
+    PcMetricsHosts& pcMetricsHosts_;
+    PcMetricsSnapshot& pcMetrics_;  // Host 0
+    PcMetricsPushReceiver& pushReceiver_;
     SystemState::CoreState& coreState_;
     SystemState::ScreenState& screenState_;
     AppConfigInterface& config_;
@@ -41,20 +59,52 @@ class TaskManager {
     // Task management
     TaskHandle_t screenTaskHandle_ = nullptr;
     TaskHandle_t backgroundTaskHandle_ = nullptr;
+    TaskHandle_t parseTaskHandle_ = nullptr;  // Only created when pipelined
     uint8_t consecutiveFailures_ = 0;
 
+    // Private parse target, published to pcMetrics_ once complete
+    PcMetrics workingMetrics_;
+    // Published sample the background task schedules from when pipelined
+    PcMetrics scheduledMetrics_;
+
+    // Buffers handed from the network stage (background task) to the parse task
+    PcMetricsPipeline pipeline_;
+
+    // Hosts after the first, one task each
+    struct HostPollTask {
+        TaskManager* manager;
+        uint8_t host;
+        std::unique_ptr<PcMetricsHostPoller> poller;
+        TaskHandle_t handle = nullptr;
+        char name[16];  // HOST_POLL_TASK_NAME and the host, FreeRTOS keeps 16 chars
+    };
+    std::vector<std::unique_ptr<HostPollTask>> hostPollTasks_;
+
+    // Poll pacing, polling only runs while a metrics screen is visible. Owned by the background
+    // task along with coreState_.nextSync_pcMetrics and consecutiveFailures_.
+    PollScheduler pollScheduler_;
+    std::atomic<bool> pollingActive_{false};  // Written by the background task, read by host tasks
+
     // Task implementations
     void executeScreenTask();
     void executeBackgroundTask();
+    void executeParseTask();
+    void executeHostPollTask(HostPollTask& task);
 
     // Helper methods
     bool createTask(TaskFunction_t taskFunction, const char* taskName, uint32_t stackSize,
                     UBaseType_t priority, TaskHandle_t* taskHandle,
-                    BaseType_t coreId = tskNO_AFFINITY);
+                    BaseType_t coreId = tskNO_AFFINITY, void* parameter = nullptr);
 
     void initializeWatchdog();
     void logStackHighWaterMark(const char* taskName);
+    void updatePollingState();
     void updatePcMetrics();
+    void fetchPcMetrics();
+    void parsePcMetrics(const PcMetricsPipeline::Sample& sample);
+    bool createHostPollTasks();
+    void completePcMetricsUpdate(bool success, unsigned long polledAtMs, uint32_t fetchTimeMs,
+                                 const PcMetrics& sample);
     void handlePcMetricsFailure();
     void resetWatchdog();
 
@@ -3,7 +3,7 @@
 #include <esp_system.h>
 
 #include "ui/DisplayManager.h"
-#include "ui/UiController.h"
+#include "ui/UIController.h"
 
 EventHandler::EventHandler(UiController* uiController, LoggerInterface& logger)
     : uiController_(uiController), logger_(logger) {
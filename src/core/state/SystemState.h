@@ -1,6 +1,6 @@
 #pragma once
 
-#include "services/pcMetrics/PcMetrics.h"
+#include "services/pcMetrics/PcMetricsSnapshot.h"
 #include "ui/screens/ScreenTypes.h"
 
 // Forward declaration
@@ -25,7 +25,7 @@ class SystemState {
     // Non-static members
     CoreState core;
     ScreenState screen;
-    PcMetrics pcMetrics;
+    PcMetricsSnapshot pcMetrics;
 
     SystemState() : core(), screen() {}
 
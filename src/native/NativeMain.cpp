@@ -0,0 +1,26 @@
+/**
+ * Entry point of the native build. SDL needs the main thread for its event
+ * loop, so setup() and loop() run on a second thread, as on the ESP32 where
+ * they run in the Arduino loop task.
+ */
+
+#include <Arduino.h>
+
+#include <LovyanGFX.hpp>
+
+void setup();
+void loop();
+
+namespace {
+int runSketch(bool* running) {
+    setup();
+    while (*running) {
+        loop();
+    }
+    return 0;
+}
+}  // namespace
+
+int main(int, char**) {
+    return lgfx::Panel_sdl::main(runSketch);
+}
@@ -0,0 +1,79 @@
+#include "AllocationCounter.h"
+
+#include <malloc.h>
+
+#include <atomic>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void __libc_free(void* pointer);
+}
+
+namespace {
+std::atomic<uint32_t> allocations{0};
+std::atomic<int64_t> liveBytes{0};
+std::atomic<int64_t> baselineBytes{0};
+std::atomic<int64_t> peakBytes{0};
+
+void added(void* pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+    allocations++;
+    int64_t live = liveBytes += malloc_usable_size(pointer);
+    int64_t peak = peakBytes.load();
+    while (live > peak && !peakBytes.compare_exchange_weak(peak, live)) {
+    }
+}
+
+void removed(void* pointer) {
+    if (pointer != nullptr) {
+        liveBytes -= malloc_usable_size(pointer);
+    }
+}
+}  // namespace
+
+extern "C" {
+void* malloc(size_t size) {
+    void* pointer = __libc_malloc(size);
+    added(pointer);
+    return pointer;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* pointer = __libc_calloc(count, size);
+    added(pointer);
+    return pointer;
+}
+
+void* realloc(void* pointer, size_t size) {
+    size_t oldSize = pointer != nullptr ? malloc_usable_size(pointer) : 0;
+    void* resized = __libc_realloc(pointer, size);
+    // A failed realloc leaves the block in place, realloc(p, 0) may free it
+    if (resized != nullptr || size == 0) {
+        liveBytes -= oldSize;
+    }
+    added(resized);
+    return resized;
+}
+
+void free(void* pointer) {
+    removed(pointer);
+    __libc_free(pointer);
+}
+}
+
+void AllocationCounter::reset() {
+    allocations = 0;
+    baselineBytes = liveBytes.load();
+    peakBytes = liveBytes.load();
+}
+
+AllocationCounter::Sample AllocationCounter::sample() {
+    Sample result;
+    result.allocations = allocations.load();
+    result.peakBytes = static_cast<size_t>(peakBytes.load() - baselineBytes.load());
+    return result;
+}
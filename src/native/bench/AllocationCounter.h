@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Counts heap allocations of the benchmark process. malloc and friends are
+ * replaced (see AllocationCounter.cpp) and forward to glibc, so this works
+ * only in the native environment on Linux.
+ */
+class AllocationCounter {
+ public:
+    struct Sample {
+        uint32_t allocations = 0;  // malloc/calloc/realloc calls since reset()
+        size_t peakBytes = 0;      // Highest live heap above the level at reset()
+    };
+
+    /**
+     * Start a new measurement from the current live heap
+     */
+    static void reset();
+    static Sample sample();
+};
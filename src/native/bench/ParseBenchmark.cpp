@@ -0,0 +1,524 @@
+/**
+ * Host benchmark of the PC metrics parse path (PcMetricsService::parseRaw).
+ *
+ * Every fixture is parsed as JSON through ArduinoJson, as JSON through
+ * LhmScanner and as the trimmed MessagePack a translating proxy would send,
+ * each in two passes:
+ *   discovery  a fresh service per iteration, so every parse searches the tree
+ *   indexed    one service, every parse reads through the sensor index
+ * One JSON line per fixture, format and pass goes to stdout, with min/p50/
+ * mean/max per stage in microseconds, allocations per parse, peak heap and the
+ * most of the JSON arena one document took. Allocations served by the arena
+ * are not counted, only those that overflowed it.
+ *
+ * A last "classify" line per fixture times sorting the sensors of every
+ * section into table rows, once with a SensorFinder search per row (strstr
+ * per row, pattern and sensor) and once with one SensorMatcher scan per
+ * sensor, and counts the sections where the two disagree.
+ *
+ * A "values" line per fixture times reading every Value, Min and Max string
+ * of the tree, once with SensorValue::parse and once the way parseValue did
+ * before it (a String, seven replace() calls, trim() and strtod), with the
+ * allocations of each per pass over the corpus. On the host String is a
+ * std::string, whose small string buffer hides some of the allocations the
+ * device makes.
+ *
+ *   pio run -e native_bench
+ *   .pio/build/native_bench/program src/native/bench/fixtures/multi_gpu.json
+ *   .pio/build/native_bench/program --iterations 1000 src/native/bench/fixtures/workstation.json
+ */
+
+#include <ArduinoJson.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "config/AppConfigService.h"
+#include "network/HttpClient.h"
+#include "services/pcMetrics/PcMetricsService.h"
+#include "services/pcMetrics/SensorFinder.h"
+#include "services/pcMetrics/SensorMatcher.h"
+#include "services/pcMetrics/SensorValue.h"
+#include "utils/ApplicationMetrics.h"
+#include "utils/LoggerInterface.h"
+
+namespace {
+
+constexpr int kDefaultIterations = 200;
+
+class QuietLogger : public LoggerInterface {
+ public:
+    void debug(const String&, bool) override {}
+    void info(const String&, bool) override {}
+    void warning(const String&, bool) override {}
+    void error(const String&, bool) override {}
+    void critical(const String&, bool) override {}
+    void debugf(const char*, ...) override {}
+    void infof(const char*, ...) override {}
+    void warningf(const char*, ...) override {}
+    void errorf(const char*, ...) override {}
+    void criticalf(const char*, ...) override {}
+    std::queue<String> getScreenMessages() override { return {}; }
+    void clearScreenMessages() override {}
+};
+
+enum class Format { ARDUINOJSON, LHM_SCANNER, MSGPACK };
+
+const char* formatName(Format format) {
+    switch (format) {
+        case Format::ARDUINOJSON:
+            return "arduinojson";
+        case Format::LHM_SCANNER:
+            return "lhmscanner";
+        case Format::MSGPACK:
+            return "msgpack";
+    }
+    return "";
+}
+
+class BenchConfig : public AppConfigService {
+ public:
+    explicit BenchConfig(bool useScanner) : useScanner_(useScanner) {}
+
+    bool getHardwareMonitorUseLhmScanner() const override { return useScanner_; }
+
+ private:
+    bool useScanner_;
+};
+
+/**
+ * Samples of one stage, reserved up front so recording does not allocate
+ */
+class Stage {
+ public:
+    explicit Stage(size_t iterations) { samples_.reserve(iterations); }
+
+    void add(uint32_t us) { samples_.push_back(us); }
+
+    void print(const char* name) {
+        std::sort(samples_.begin(), samples_.end());
+        uint64_t sum = 0;
+        for (uint32_t sample : samples_) {
+            sum += sample;
+        }
+        size_t count = samples_.size();
+        printf("\"%s\":{\"min\":%u,\"p50\":%u,\"mean\":%.1f,\"max\":%u}", name,
+               count ? samples_.front() : 0, count ? samples_[count / 2] : 0,
+               count ? static_cast<double>(sum) / count : 0.0, count ? samples_.back() : 0);
+    }
+
+ private:
+    std::vector<uint32_t> samples_;
+};
+
+struct PassResult {
+    explicit PassResult(size_t iterations)
+        : total(iterations),
+          deserialize(iterations),
+          indexRead(iterations),
+          hardwareFind(iterations),
+          hardwareParse{Stage(iterations), Stage(iterations), Stage(iterations),
+                        Stage(iterations)},
+          derive(iterations) {}
+
+    Stage total;
+    Stage deserialize;
+    Stage indexRead;
+    Stage hardwareFind;
+    Stage hardwareParse[HARDWARE_KIND_COUNT];
+    Stage derive;
+    uint64_t allocations = 0;
+    size_t peakBytes = 0;
+    size_t arenaBytes = 0;
+    int failures = 0;
+    uint8_t threads = 0;
+};
+
+static_assert(HARDWARE_KIND_COUNT == 4, "PassResult initialises one Stage per HardwareKind");
+
+bool readFile(const char* path, String& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    out.reserve(content.size());
+    return out.concat(content.data(), content.size());
+}
+
+/**
+ * Trim a node to Text, numeric Value and Children, as tools/lhm_msgpack_proxy.py does
+ */
+void trimNode(JsonObjectConst in, JsonObject out) {
+    out["Text"] = in["Text"] | "";
+
+    float value;
+    SensorUnit unit;
+    if (SensorValue::parse(in["Value"] | "", value, unit)) {
+        if (unit == SensorUnit::GIGABYTE) {
+            value = SensorValue::convert(value, unit, SensorUnit::MEGABYTE);
+        }
+        out["Value"] = value;
+    }
+
+    JsonArrayConst children = in["Children"];
+    if (children.size() > 0) {
+        JsonArray outChildren = out["Children"].to<JsonArray>();
+        for (JsonObjectConst child : children) {
+            trimNode(child, outChildren.add<JsonObject>());
+        }
+    }
+}
+
+bool toMsgPack(const String& json, String& out) {
+    JsonDocument source;
+    if (deserializeJson(source, json, DeserializationOption::NestingLimit(16))) {
+        return false;
+    }
+    JsonDocument trimmed;
+    trimNode(source.as<JsonObjectConst>(), trimmed.to<JsonObject>());
+
+    // Through std::string: MessagePack contains zero bytes
+    std::string packed;
+    serializeMsgPack(trimmed, packed);
+    out.reserve(packed.size());
+    return out.concat(packed.data(), packed.size());
+}
+
+void record(const PcMetricsService& service, uint32_t totalUs, const PcMetrics& metrics,
+            PassResult& result) {
+    const PcMetricsService::ParseTimings& timings = service.getLastParseTimings();
+    result.total.add(totalUs);
+    result.deserialize.add(timings.deserializeUs);
+    result.indexRead.add(timings.indexReadUs);
+    result.hardwareFind.add(timings.hardwareFindUs);
+    for (size_t kind = 0; kind < HARDWARE_KIND_COUNT; kind++) {
+        result.hardwareParse[kind].add(timings.hardwareParseUs[kind]);
+    }
+    result.derive.add(timings.deriveUs);
+    result.threads = metrics.cpu_thread_count;
+}
+
+/**
+ * Parse once, counting the allocations and live heap of that parse only
+ */
+bool measuredParse(PcMetricsService& service, const String& payload, PcMetrics& metrics,
+                   PassResult& result) {
+    AllocationCounter::reset();
+    unsigned long start = micros();
+    bool ok = service.parseRaw(payload, 0, metrics);
+    uint32_t totalUs = micros() - start;
+    AllocationCounter::Sample sample = AllocationCounter::sample();
+
+    result.allocations += sample.allocations;
+    result.peakBytes = std::max(result.peakBytes, sample.peakBytes);
+    result.arenaBytes = std::max(result.arenaBytes, service.getJsonArena().highWater());
+    result.failures += ok ? 0 : 1;
+    record(service, totalUs, metrics, result);
+    return ok;
+}
+
+void runPass(const char* fixture, Format format, const String& payload, bool indexed,
+             int iterations) {
+    QuietLogger logger;
+    BenchConfig config(format == Format::LHM_SCANNER);
+    ApplicationMetrics metrics(config);
+    HttpClient httpClient;
+    PcMetrics data;
+    PassResult result(iterations);
+
+    if (indexed) {
+        PcMetricsService service(httpClient, "", metrics, logger, config);
+        service.parseRaw(payload, 0, data);  // Builds the sensor index
+        for (int i = 0; i < iterations; i++) {
+            measuredParse(service, payload, data, result);
+        }
+    } else {
+        for (int i = 0; i < iterations; i++) {
+            PcMetricsService service(httpClient, "", metrics, logger, config);
+            measuredParse(service, payload, data, result);
+        }
+    }
+
+    printf("{\"fixture\":\"%s\",\"format\":\"%s\",\"pass\":\"%s\",\"bytes\":%u,"
+           "\"iterations\":%d,\"failures\":%d,\"cpu_threads\":%u,",
+           fixture, formatName(format), indexed ? "indexed" : "discovery", payload.length(),
+           iterations, result.failures, result.threads);
+    result.total.print("total_us");
+    printf(",");
+    result.deserialize.print("deserialize_us");
+    printf(",");
+    result.indexRead.print("index_read_us");
+    printf(",");
+    result.hardwareFind.print("hardware_find_us");
+    for (size_t kind = 0; kind < HARDWARE_KIND_COUNT; kind++) {
+        char name[32];
+        snprintf(name, sizeof(name), "parse_%s_us", SensorRegistry::hardware()[kind].name);
+        printf(",");
+        result.hardwareParse[kind].print(name);
+    }
+    printf(",");
+    result.derive.print("derive_us");
+    printf(",\"allocations_per_parse\":%.1f,\"peak_heap_bytes\":%zu,\"arena_bytes\":%zu}\n",
+           static_cast<double>(result.allocations) / iterations, result.peakBytes,
+           result.arenaBytes);
+    fflush(stdout);
+}
+
+/**
+ * Nodes whose Children are sensors, anywhere in the tree
+ */
+void collectSections(JsonObject node, std::vector<JsonObject>& out) {
+    JsonArray children = node["Children"];
+    if (children.size() == 0) {
+        return;
+    }
+    if (children[0]["Children"].size() == 0) {
+        out.push_back(node);
+        return;
+    }
+    for (JsonObject child : children) {
+        collectSections(child, out);
+    }
+}
+
+// chosen[i]: index of the sensor assigned to row i, -1 if none
+void classifyPerRow(JsonObject section, int* chosen) {
+    const char* text = section["Text"] | "";
+    JsonArray sensors = section["Children"];
+    for (size_t i = 0; i < SensorRegistry::sensorCount(); i++) {
+        const SensorDescriptor& row = SensorRegistry::sensors()[i];
+        chosen[i] = -1;
+        if (strstr(text, row.section) == nullptr) {
+            continue;
+        }
+        // Patterns in rank order, the first sensor containing the best one
+        for (const char* pattern : row.match) {
+            if (pattern != nullptr && chosen[i] < 0) {
+                SensorFinder::findContaining(sensors, pattern, &chosen[i]);
+            }
+        }
+    }
+}
+
+void classifyMatcher(JsonObject section, int* chosen) {
+    const SensorMatcher& matcher = SensorMatcher::instance();
+    std::fill(chosen, chosen + SensorRegistry::sensorCount(), -1);
+    uint32_t open = matcher.scan(section["Text"] | "").sectionRows;
+    size_t rank[SENSOR_COUNT];
+    std::fill(rank, rank + SENSOR_COUNT, SENSOR_MATCH_PATTERNS);
+
+    int sensorIndex = -1;
+    for (JsonObject sensor : section["Children"].as<JsonArray>()) {
+        if (open == 0) {
+            break;
+        }
+        sensorIndex++;
+        SensorMatcher::Matches matches = matcher.scan(sensor["Text"] | "");
+        for (size_t r = 0; r < SENSOR_MATCH_PATTERNS; r++) {
+            uint32_t matched = matches.patternRows[r] & open;
+            while (matched != 0) {
+                size_t row = __builtin_ctz(matched);
+                matched &= matched - 1;
+                if (r < rank[row]) {
+                    rank[row] = r;
+                    chosen[row] = sensorIndex;
+                }
+                if (r == 0) {
+                    open &= ~(1u << row);
+                }
+            }
+        }
+    }
+}
+
+void runClassify(const char* fixture, const String& json, int iterations) {
+    JsonDocument doc;
+    if (deserializeJson(doc, json, DeserializationOption::NestingLimit(16))) {
+        return;
+    }
+    std::vector<JsonObject> sections;
+    collectSections(doc.as<JsonObject>(), sections);
+    size_t sensors = 0;
+    for (JsonObject section : sections) {
+        sensors += section["Children"].size();
+    }
+
+    const size_t rows = SensorRegistry::sensorCount();
+    std::vector<int> perRow(sections.size() * rows);
+    std::vector<int> matched(sections.size() * rows);
+    Stage perRowUs(iterations);
+    Stage matcherUs(iterations);
+    SensorMatcher::instance();  // Built outside the timing, as at startup
+
+    for (int i = 0; i < iterations; i++) {
+        unsigned long start = micros();
+        for (size_t s = 0; s < sections.size(); s++) {
+            classifyPerRow(sections[s], &perRow[s * rows]);
+        }
+        perRowUs.add(micros() - start);
+
+        start = micros();
+        for (size_t s = 0; s < sections.size(); s++) {
+            classifyMatcher(sections[s], &matched[s * rows]);
+        }
+        matcherUs.add(micros() - start);
+    }
+
+    int mismatches = 0;
+    for (size_t s = 0; s < sections.size(); s++) {
+        auto first = perRow.begin() + s * rows;
+        mismatches += std::equal(first, first + rows, matched.begin() + s * rows) ? 0 : 1;
+    }
+
+    printf("{\"fixture\":\"%s\",\"format\":\"classify\",\"sections\":%zu,\"sensors\":%zu,"
+           "\"matcher_states\":%zu,\"mismatches\":%d,",
+           fixture, sections.size(), sensors, SensorMatcher::instance().stateCount(), mismatches);
+    perRowUs.print("per_row_us");
+    printf(",");
+    matcherUs.print("matcher_us");
+    printf("}\n");
+    fflush(stdout);
+}
+
+/**
+ * Value, Min and Max strings anywhere in the tree
+ */
+void collectValues(JsonObjectConst node, std::vector<std::string>& out) {
+    for (const char* key : {"Value", "Min", "Max"}) {
+        const char* text = node[key];
+        if (text != nullptr) {
+            out.emplace_back(text);
+        }
+    }
+    for (JsonObjectConst child : node["Children"].as<JsonArrayConst>()) {
+        collectValues(child, out);
+    }
+}
+
+// parseValue before SensorValue, kept to compare against
+bool parseByReplace(const char* text, float& outValue) {
+    String str = text;
+    str.replace("%", "");
+    str.replace(" °C", "");
+    str.replace(" RPM", "");
+    str.replace(" W", "");
+    str.replace(" V", "");
+    str.replace(" MB", "");
+    str.replace(" GB", "");
+    str.trim();
+
+    char* endPtr;
+    outValue = strtod(str.c_str(), &endPtr);
+    return endPtr != str.c_str();
+}
+
+void runValues(const char* fixture, const String& json, int iterations) {
+    JsonDocument doc;
+    if (deserializeJson(doc, json, DeserializationOption::NestingLimit(16))) {
+        return;
+    }
+    std::vector<std::string> values;
+    collectValues(doc.as<JsonObjectConst>(), values);
+
+    size_t parsed = 0;
+    size_t unknownUnits = 0;
+    size_t disagreements = 0;  // Both read a number, but not the same one
+    for (const std::string& text : values) {
+        float value;
+        float replaced;
+        SensorUnit unit;
+        if (!SensorValue::parse(text.c_str(), value, unit)) {
+            continue;
+        }
+        parsed++;
+        unknownUnits += unit == SensorUnit::UNKNOWN ? 1 : 0;
+        if (parseByReplace(text.c_str(), replaced) && replaced != value) {
+            disagreements++;
+        }
+    }
+
+    Stage sensorValueUs(iterations);
+    Stage replaceUs(iterations);
+    uint64_t sensorValueAllocations = 0;
+    uint64_t replaceAllocations = 0;
+    volatile float sink = 0.0f;  // Keeps the results alive
+    for (int i = 0; i < iterations; i++) {
+        AllocationCounter::reset();
+        unsigned long start = micros();
+        for (const std::string& text : values) {
+            float value;
+            SensorUnit unit;
+            if (SensorValue::parse(text.c_str(), value, unit)) {
+                sink = sink + value;
+            }
+        }
+        sensorValueUs.add(micros() - start);
+        sensorValueAllocations += AllocationCounter::sample().allocations;
+
+        AllocationCounter::reset();
+        start = micros();
+        for (const std::string& text : values) {
+            float value;
+            if (parseByReplace(text.c_str(), value)) {
+                sink = sink + value;
+            }
+        }
+        replaceUs.add(micros() - start);
+        replaceAllocations += AllocationCounter::sample().allocations;
+    }
+
+    printf("{\"fixture\":\"%s\",\"format\":\"values\",\"values\":%zu,\"parsed\":%zu,"
+           "\"unknown_units\":%zu,\"disagreements\":%zu,",
+           fixture, values.size(), parsed, unknownUnits, disagreements);
+    sensorValueUs.print("sensor_value_us");
+    printf(",\"sensor_value_allocations_per_pass\":%.1f,",
+           static_cast<double>(sensorValueAllocations) / iterations);
+    replaceUs.print("string_replace_us");
+    printf(",\"string_replace_allocations_per_pass\":%.1f}\n",
+           static_cast<double>(replaceAllocations) / iterations);
+    fflush(stdout);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int iterations = kDefaultIterations;
+    std::vector<const char*> fixtures;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::max(1, atoi(argv[++i]));
+        } else {
+            fixtures.push_back(argv[i]);
+        }
+    }
+    if (fixtures.empty()) {
+        fprintf(stderr, "usage: %s [--iterations N] fixture.json...\n", argv[0]);
+        return 2;
+    }
+
+    int status = 0;
+    for (const char* fixture : fixtures) {
+        String json;
+        String msgpack;
+        if (!readFile(fixture, json) || !toMsgPack(json, msgpack)) {
+            fprintf(stderr, "%s: cannot read or convert\n", fixture);
+            status = 1;
+            continue;
+        }
+
+        const char* name = strrchr(fixture, '/') != nullptr ? strrchr(fixture, '/') + 1 : fixture;
+        for (Format format : {Format::ARDUINOJSON, Format::LHM_SCANNER, Format::MSGPACK}) {
+            const String& payload = format == Format::MSGPACK ? msgpack : json;
+            runPass(name, format, payload, false, iterations);
+            runPass(name, format, payload, true, iterations);
+        }
+        runClassify(name, json, iterations);
+        runValues(name, json, iterations);
+    }
+    return status;
+}
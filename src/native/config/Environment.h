@@ -0,0 +1,14 @@
+#pragma once
+
+// Environment of the native build: no WiFi, and the PC metrics come from the
+// mock server of tools/mock_lhm_server.py on this machine
+
+constexpr char WIFI_SSID[] = "native";
+constexpr char WIFI_PASSWORD[] = "";
+
+constexpr char LIBRE_HM_API[] = "http://127.0.0.1:8085/data.json";
+
+// Start the mock server with --ports 8085 8086 to watch a second host
+// #define LIBRE_HM_EXTRA_HOSTS "http://127.0.0.1:8086/data.json"
+
+constexpr char AIR_VISUAL_API[] = "";
@@ -0,0 +1,419 @@
+#pragma once
+
+/**
+ * Minimal Arduino core for the native (Linux host) environments: String,
+ * Stream, Serial, the timing functions and the ESP heap queries, as far as
+ * the code built there uses them. Behaviour follows the ESP32 core.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <strings.h>
+#include <functional>  // Both this and <stdexcept> come with the ESP32 core, as <vector>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>  // Reached through the ESP32 core headers, code relies on it
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+namespace native {
+inline std::chrono::steady_clock::time_point startTime() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+}  // namespace native
+
+inline unsigned long micros() {
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                          std::chrono::steady_clock::now() - native::startTime())
+                                          .count());
+}
+
+inline unsigned long millis() {
+    return micros() / 1000;
+}
+
+inline void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+template <typename T, typename L, typename H>
+inline T constrain(T value, L low, H high) {
+    return value < low ? low : (value > high ? high : value);
+}
+
+inline long random(long low, long high) {
+    return high > low ? low + std::rand() % (high - low) : low;
+}
+
+inline long random(long high) {
+    return random(0, high);
+}
+
+/**
+ * The host clock is already set, so SNTP setup is a no-op
+ */
+inline void configTime(long, int, const char*, const char* = nullptr, const char* = nullptr) {}
+
+inline bool getLocalTime(struct tm* info, uint32_t = 5000) {
+    time_t now = time(nullptr);
+    return localtime_r(&now, info) != nullptr;
+}
+
+// ============================================================================
+// String
+// ============================================================================
+
+class String {
+ public:
+    String() = default;
+    String(const char* text) : s_(text != nullptr ? text : "") {}
+    String(const String&) = default;
+    String(String&&) = default;
+    explicit String(char c) : s_(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) : String(format(value, base)) {}
+    String(int value, unsigned char base = 10) : String(format(value, base)) {}
+    String(unsigned int value, unsigned char base = 10) : String(format(value, base)) {}
+    String(long value, unsigned char base = 10) : String(format(value, base)) {}
+    String(unsigned long value, unsigned char base = 10) : String(format(value, base)) {}
+    String(float value, unsigned int decimals = 2) : String(fixed(value, decimals)) {}
+    String(double value, unsigned int decimals = 2) : String(fixed(value, decimals)) {}
+
+    String& operator=(const String&) = default;
+    String& operator=(String&&) = default;
+    String& operator=(const char* text) {
+        s_ = text != nullptr ? text : "";
+        return *this;
+    }
+
+    const char* c_str() const { return s_.c_str(); }
+    unsigned int length() const { return static_cast<unsigned int>(s_.size()); }
+    bool isEmpty() const { return s_.empty(); }
+    bool reserve(unsigned int size) {
+        s_.reserve(size);
+        return true;
+    }
+
+    bool concat(const String& other) { return concat(other.s_.data(), other.length()); }
+    bool concat(const char* text) { return text != nullptr && concat(text, strlen(text)); }
+    bool concat(const char* text, unsigned int length) {
+        if (text == nullptr) {
+            return false;
+        }
+        s_.append(text, length);
+        return true;
+    }
+    bool concat(char c) {
+        s_.push_back(c);
+        return true;
+    }
+
+    String& operator+=(const String& other) {
+        concat(other);
+        return *this;
+    }
+    String& operator+=(const char* text) {
+        concat(text);
+        return *this;
+    }
+    String& operator+=(char c) {
+        concat(c);
+        return *this;
+    }
+    String& operator+=(int value) {
+        concat(String(value));
+        return *this;
+    }
+    String& operator+=(unsigned int value) {
+        concat(String(value));
+        return *this;
+    }
+    String& operator+=(long value) {
+        concat(String(value));
+        return *this;
+    }
+    String& operator+=(unsigned long value) {
+        concat(String(value));
+        return *this;
+    }
+
+    char operator[](unsigned int index) const { return index < s_.size() ? s_[index] : 0; }
+    char& operator[](unsigned int index) { return s_[index]; }
+    char charAt(unsigned int index) const { return (*this)[index]; }
+
+    bool operator==(const String& other) const { return s_ == other.s_; }
+    bool operator==(const char* text) const { return s_ == (text != nullptr ? text : ""); }
+    bool operator!=(const String& other) const { return !(*this == other); }
+    bool operator!=(const char* text) const { return !(*this == text); }
+    bool operator<(const String& other) const { return s_ < other.s_; }
+    bool equals(const String& other) const { return *this == other; }
+    bool equalsIgnoreCase(const String& other) const {
+        return s_.size() == other.s_.size() && strcasecmp(s_.c_str(), other.s_.c_str()) == 0;
+    }
+
+    int indexOf(char c, unsigned int from = 0) const { return position(s_.find(c, from)); }
+    int indexOf(const char* text, unsigned int from = 0) const {
+        return position(s_.find(text, from));
+    }
+    int indexOf(const String& text, unsigned int from = 0) const {
+        return position(s_.find(text.s_, from));
+    }
+    int lastIndexOf(char c) const { return position(s_.rfind(c)); }
+    bool startsWith(const String& prefix) const { return s_.rfind(prefix.s_, 0) == 0; }
+    bool endsWith(const String& suffix) const {
+        return s_.size() >= suffix.s_.size() &&
+               s_.compare(s_.size() - suffix.s_.size(), suffix.s_.size(), suffix.s_) == 0;
+    }
+
+    String substring(unsigned int from) const { return substring(from, length()); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) {
+            std::swap(from, to);
+        }
+        if (from >= s_.size()) {
+            return String();
+        }
+        String result;
+        result.s_ = s_.substr(from, std::min<size_t>(to, s_.size()) - from);
+        return result;
+    }
+
+    void remove(unsigned int index) { remove(index, length()); }
+    void remove(unsigned int index, unsigned int count) {
+        if (index < s_.size()) {
+            s_.erase(index, count);
+        }
+    }
+    void replace(const String& find, const String& with) {
+        if (find.s_.empty()) {
+            return;
+        }
+        for (size_t at = s_.find(find.s_); at != std::string::npos;
+             at = s_.find(find.s_, at + with.s_.size())) {
+            s_.replace(at, find.s_.size(), with.s_);
+        }
+    }
+    void trim() {
+        size_t first = s_.find_first_not_of(" \t\r\n");
+        size_t last = s_.find_last_not_of(" \t\r\n");
+        s_ = first == std::string::npos ? std::string() : s_.substr(first, last - first + 1);
+    }
+    void toLowerCase() {
+        std::transform(s_.begin(), s_.end(), s_.begin(), ::tolower);
+    }
+    void toUpperCase() {
+        std::transform(s_.begin(), s_.end(), s_.begin(), ::toupper);
+    }
+
+    long toInt() const { return strtol(s_.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(s_.c_str(), nullptr); }
+
+ private:
+    std::string s_;
+
+    static int position(size_t index) {
+        return index == std::string::npos ? -1 : static_cast<int>(index);
+    }
+
+    template <typename T>
+    static String format(T value, unsigned char base) {
+        char buffer[72];
+        if (base == 16) {
+            snprintf(buffer, sizeof(buffer), "%llx", static_cast<unsigned long long>(value));
+        } else if (std::is_signed<T>::value) {
+            snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+        } else {
+            snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(value));
+        }
+        return String(static_cast<const char*>(buffer));
+    }
+
+    static String fixed(double value, unsigned int decimals) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(decimals), value);
+        return String(static_cast<const char*>(buffer));
+    }
+};
+
+// Result type of String concatenation in the Arduino core
+class StringSumHelper : public String {
+ public:
+    using String::String;
+    StringSumHelper(const String& other) : String(other) {}
+};
+
+inline StringSumHelper operator+(const String& left, const String& right) {
+    StringSumHelper result(left);
+    result += right;
+    return result;
+}
+
+inline StringSumHelper operator+(const String& left, const char* right) {
+    StringSumHelper result(left);
+    result += right;
+    return result;
+}
+
+inline StringSumHelper operator+(const char* left, const String& right) {
+    StringSumHelper result(left);
+    result += right;
+    return result;
+}
+
+inline StringSumHelper operator+(const String& left, char right) {
+    StringSumHelper result(left);
+    result += right;
+    return result;
+}
+
+// ============================================================================
+// Print and Stream
+// ============================================================================
+
+class Print {
+ public:
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* data, size_t size) {
+        size_t written = 0;
+        while (written < size && write(data[written])) {
+            written++;
+        }
+        return written;
+    }
+    size_t write(const char* text) {
+        return write(reinterpret_cast<const uint8_t*>(text), strlen(text));
+    }
+
+    size_t print(const char* text) { return write(text); }
+    size_t print(const String& text) { return write(text.c_str()); }
+    size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+    size_t print(int value) { return print(String(value)); }
+    size_t print(unsigned int value) { return print(String(value)); }
+    size_t print(long value) { return print(String(value)); }
+    size_t print(unsigned long value) { return print(String(value)); }
+    size_t print(double value, int decimals = 2) { return print(String(value, decimals)); }
+
+    size_t println() { return write("\n"); }
+    template <typename T>
+    size_t println(const T& value) {
+        return print(value) + println();
+    }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        char buffer[256];
+        va_list args;
+        va_start(args, format);
+        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        if (length < 0) {
+            return 0;
+        }
+        return write(reinterpret_cast<const uint8_t*>(buffer),
+                     std::min<size_t>(length, sizeof(buffer) - 1));
+    }
+};
+
+class Stream : public Print {
+ public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    /**
+     * Read up to length bytes, waiting at most the timeout for each
+     */
+    virtual size_t readBytes(char* buffer, size_t length) {
+        size_t count = 0;
+        while (count < length) {
+            int c = timedRead();
+            if (c < 0) {
+                break;
+            }
+            buffer[count++] = static_cast<char>(c);
+        }
+        return count;
+    }
+    size_t readBytes(uint8_t* buffer, size_t length) {
+        return readBytes(reinterpret_cast<char*>(buffer), length);
+    }
+
+    void setTimeout(unsigned long timeoutMs) { timeout_ = timeoutMs; }
+    unsigned long getTimeout() const { return timeout_; }
+
+ protected:
+    unsigned long timeout_ = 1000;
+
+    int timedRead() {
+        unsigned long start = millis();
+        do {
+            int c = read();
+            if (c >= 0) {
+                return c;
+            }
+            delay(1);
+        } while (millis() - start < timeout_);
+        return -1;
+    }
+};
+
+// ============================================================================
+// Serial and ESP
+// ============================================================================
+
+class HardwareSerial : public Stream {
+ public:
+    void begin(unsigned long) {}
+    explicit operator bool() const { return true; }
+
+    size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+    size_t write(const uint8_t* data, size_t size) override {
+        return fwrite(data, 1, size, stdout);
+    }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+
+inline HardwareSerial Serial;
+
+/**
+ * Heap queries report a fixed device-sized heap: the host has no equivalent,
+ * and the native tools measure allocations themselves.
+ */
+class EspClass {
+ public:
+    uint32_t getHeapSize() const { return 320 * 1024; }
+    uint32_t getFreeHeap() const { return 200 * 1024; }
+    uint32_t getMinFreeHeap() const { return 200 * 1024; }
+    uint32_t getMaxAllocHeap() const { return 110 * 1024; }
+    uint32_t getPsramSize() const { return 2 * 1024 * 1024; }
+    uint32_t getFreePsram() const { return 2 * 1024 * 1024; }
+    uint32_t getCpuFreqMHz() const { return 240; }
+    const char* getSdkVersion() const { return "native"; }
+    void restart() { std::exit(0); }
+};
+
+inline EspClass ESP;
@@ -0,0 +1,250 @@
+#include <Arduino.h>
+#include <pthread.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+namespace {
+/**
+ * Wait on condition until ready() holds or ticks have passed
+ */
+template <typename Ready>
+bool waitFor(std::condition_variable& condition, std::unique_lock<std::mutex>& lock,
+             TickType_t ticks, Ready ready) {
+    if (ticks == portMAX_DELAY) {
+        condition.wait(lock, ready);
+        return true;
+    }
+    return condition.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+// ESP32 stacks are sized for 32-bit code, pointers and frames are larger here
+constexpr size_t kStackScale = 4;
+constexpr size_t kMinStackBytes = 128 * 1024;
+}  // namespace
+
+// ============================================================================
+// Tasks
+// ============================================================================
+
+struct NativeTask {
+    pthread_t thread;
+    std::string name;
+    TaskFunction_t function;
+    void* parameter;
+
+    std::mutex notifyMutex;
+    std::condition_variable notified;
+    uint32_t notifyCount = 0;
+};
+
+namespace {
+thread_local NativeTask* currentTask = nullptr;
+
+void* runTask(void* argument) {
+    auto* task = static_cast<NativeTask*>(argument);
+    currentTask = task;
+    pthread_setname_np(pthread_self(), task->name.substr(0, 15).c_str());
+    task->function(task->parameter);
+    return nullptr;  // Like FreeRTOS, a task must not return; tolerated here
+}
+}  // namespace
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t taskFunction, const char* taskName,
+                                   uint32_t stackSize, void* parameter, UBaseType_t,
+                                   TaskHandle_t* outHandle, BaseType_t) {
+    auto* task = new NativeTask();
+    task->name = taskName != nullptr ? taskName : "";
+    task->function = taskFunction;
+    task->parameter = parameter;
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes,
+                              std::max<size_t>(stackSize * kStackScale, kMinStackBytes));
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    int error = pthread_create(&task->thread, &attributes, runTask, task);
+    pthread_attr_destroy(&attributes);
+
+    if (error != 0) {
+        delete task;
+        return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+    }
+    if (outHandle != nullptr) {
+        *outHandle = task;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t taskFunction, const char* taskName, uint32_t stackSize,
+                       void* parameter, UBaseType_t priority, TaskHandle_t* outHandle) {
+    return xTaskCreatePinnedToCore(taskFunction, taskName, stackSize, parameter, priority,
+                                   outHandle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (task == nullptr || task == currentTask) {
+        pthread_exit(nullptr);
+    }
+    // The task ends at its next delay or blocking call. Its NativeTask is kept,
+    // the handle may still be held elsewhere.
+    pthread_cancel(task->thread);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t period) {
+    *previousWakeTime += period;
+    std::this_thread::sleep_until(native::startTime() +
+                                  std::chrono::milliseconds(*previousWakeTime));
+}
+
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(millis());
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return currentTask;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) {
+    return 0;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticks) {
+    NativeTask* task = currentTask;
+    if (task == nullptr) {
+        vTaskDelay(ticks);  // Not a task, nothing can notify it
+        return 0;
+    }
+    std::unique_lock<std::mutex> lock(task->notifyMutex);
+    if (!waitFor(task->notified, lock, ticks, [task] { return task->notifyCount > 0; })) {
+        return 0;
+    }
+    uint32_t count = task->notifyCount;
+    task->notifyCount = clearCountOnExit ? 0 : count - 1;
+    return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    {
+        std::lock_guard<std::mutex> lock(task->notifyMutex);
+        task->notifyCount++;
+    }
+    task->notified.notify_one();
+    return pdPASS;
+}
+
+// ============================================================================
+// Queues
+// ============================================================================
+
+struct NativeQueue {
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<std::vector<uint8_t>> items;
+    size_t length;
+    size_t itemSize;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    auto* queue = new NativeQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->notFull, lock, ticks,
+                 [queue] { return queue->items.size() < queue->length; })) {
+        return pdFALSE;
+    }
+    const auto* bytes = static_cast<const uint8_t*>(item);
+    queue->items.emplace_back(bytes, bytes + queue->itemSize);
+    queue->notEmpty.notify_one();
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* outItem, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->notEmpty, lock, ticks, [queue] { return !queue->items.empty(); })) {
+        return pdFALSE;
+    }
+    memcpy(outItem, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    queue->notFull.notify_one();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->items.size();
+}
+
+// ============================================================================
+// Semaphores
+// ============================================================================
+
+struct NativeSemaphore {
+    std::mutex mutex;
+    std::condition_variable available;
+    UBaseType_t count;
+    UBaseType_t maxCount;
+};
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+    auto* semaphore = new NativeSemaphore();
+    semaphore->count = initialCount;
+    semaphore->maxCount = maxCount;
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return xSemaphoreCreateCounting(1, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return xSemaphoreCreateCounting(1, 0);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    if (!waitFor(semaphore->available, lock, ticks, [semaphore] { return semaphore->count > 0; })) {
+        return pdFALSE;
+    }
+    semaphore->count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    if (semaphore->count >= semaphore->maxCount) {
+        return pdFALSE;
+    }
+    semaphore->count++;
+    semaphore->available.notify_one();
+    return pdTRUE;
+}
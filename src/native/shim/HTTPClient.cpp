@@ -0,0 +1,212 @@
+#include "HTTPClient.h"
+
+#include <StreamString.h>
+#include <strings.h>
+
+#include <cstdlib>
+
+bool HTTPClient::begin(WiFiClient& client, const char* url) {
+    client_ = &client;
+    headers_.clear();
+    size_ = -1;
+    chunked_ = false;
+
+    std::string text(url);
+    const std::string scheme = "http://";
+    if (text.compare(0, scheme.size(), scheme) != 0) {
+        return false;  // No TLS on the host either
+    }
+    text = text.substr(scheme.size());
+
+    size_t slash = text.find('/');
+    std::string authority = text.substr(0, slash);
+    path_ = slash == std::string::npos ? "/" : text.substr(slash);
+
+    size_t colon = authority.rfind(':');
+    host_ = authority.substr(0, colon);
+    port_ = colon == std::string::npos ? 80 : atoi(authority.c_str() + colon + 1);
+    return true;
+}
+
+void HTTPClient::end() {
+    if (client_ == nullptr) {
+        return;
+    }
+    if (reuse_ && canReuse_) {
+        // Drop what the caller left of the body, the next response follows it
+        while (client_->available() > 0) {
+            client_->read();
+        }
+    } else {
+        client_->stop();
+    }
+}
+
+void HTTPClient::addHeader(const char* name, const char* value) {
+    headers_.emplace_back(name, value);
+}
+
+void HTTPClient::collectHeaders(const char* headerKeys[], size_t headerKeysCount) {
+    responseHeaders_.clear();
+    for (size_t i = 0; i < headerKeysCount; i++) {
+        responseHeaders_.emplace_back(headerKeys[i], "");
+    }
+}
+
+String HTTPClient::header(const char* name) const {
+    for (const auto& header : responseHeaders_) {
+        if (strcasecmp(header.first.c_str(), name) == 0) {
+            return String(header.second.c_str());
+        }
+    }
+    return String();
+}
+
+int HTTPClient::GET() {
+    if (client_ == nullptr) {
+        return HTTPC_ERROR_NOT_CONNECTED;
+    }
+
+    // Like the ESP32 core, an open socket is used whatever server it goes to
+    if (!client_->connected()) {
+        if (!client_->connect(host_.c_str(), port_, timeoutMs_)) {
+            return HTTPC_ERROR_CONNECTION_REFUSED;
+        }
+        client_->setNoDelay(true);
+    }
+    client_->setTimeout(timeoutMs_);
+
+    std::string request = "GET " + path_ + (http10_ ? " HTTP/1.0\r\n" : " HTTP/1.1\r\n");
+    request += "Host: " + host_ + (port_ != 80 ? ":" + std::to_string(port_) : "") + "\r\n";
+    request += "User-Agent: ESP32HTTPClient\r\n";
+    request += reuse_ ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    for (const auto& header : headers_) {
+        request += header.first + ": " + header.second + "\r\n";
+    }
+    request += "\r\n";
+
+    const auto* bytes = reinterpret_cast<const uint8_t*>(request.data());
+    if (client_->write(bytes, request.size()) != request.size()) {
+        client_->stop();
+        return HTTPC_ERROR_SEND_HEADER_FAILED;
+    }
+    return readResponseHeaders();
+}
+
+bool HTTPClient::readLine(std::string& line) {
+    line.clear();
+    char c;
+    while (client_->readBytes(&c, 1) == 1) {
+        if (c == '\n') {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            return true;
+        }
+        line.push_back(c);
+    }
+    return false;
+}
+
+int HTTPClient::readResponseHeaders() {
+    std::string line;
+    if (!readLine(line)) {
+        client_->stop();
+        return HTTPC_ERROR_READ_TIMEOUT;
+    }
+    // "HTTP/1.1 200 OK"
+    size_t space = line.find(' ');
+    if (line.compare(0, 5, "HTTP/") != 0 || space == std::string::npos) {
+        client_->stop();
+        return HTTPC_ERROR_NO_HTTP_SERVER;
+    }
+    int code = atoi(line.c_str() + space + 1);
+    canReuse_ = !http10_ && line.compare(0, 8, "HTTP/1.0") != 0;
+    for (auto& header : responseHeaders_) {
+        header.second.clear();
+    }
+
+    while (readLine(line) && !line.empty()) {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = line.substr(0, colon);
+        const char* value = line.c_str() + colon + 1;
+        while (*value == ' ') {
+            value++;
+        }
+
+        for (auto& header : responseHeaders_) {
+            if (strcasecmp(header.first.c_str(), name.c_str()) == 0) {
+                header.second = value;
+            }
+        }
+        if (strcasecmp(name.c_str(), "Content-Length") == 0) {
+            size_ = atoi(value);
+        } else if (strcasecmp(name.c_str(), "Transfer-Encoding") == 0) {
+            chunked_ = strcasecmp(value, "chunked") == 0;
+        } else if (strcasecmp(name.c_str(), "Connection") == 0) {
+            canReuse_ = canReuse_ && strcasecmp(value, "close") != 0;
+        }
+    }
+    if (line.size() > 0) {
+        client_->stop();
+        return HTTPC_ERROR_CONNECTION_LOST;
+    }
+
+    // A body of unknown length ends with the connection
+    canReuse_ = canReuse_ && (size_ >= 0 || chunked_);
+    return code;
+}
+
+String HTTPClient::getString() {
+    StreamString body;
+    if (size_ > 0) {
+        body.reserve(size_);
+    }
+    writeToStream(&body);
+    return body;
+}
+
+int HTTPClient::writeToStream(Stream* stream) {
+    char buffer[1460];
+    int written = 0;
+
+    auto copy = [&](int length) {
+        // length < 0: until the server closes the connection
+        while (length != 0) {
+            size_t want = length < 0 ? sizeof(buffer)
+                                     : std::min<size_t>(length, sizeof(buffer));
+            size_t got = client_->readBytes(buffer, want);
+            if (got == 0) {
+                return length < 0;
+            }
+            if (stream->write(reinterpret_cast<const uint8_t*>(buffer), got) != got) {
+                return false;
+            }
+            written += got;
+            if (length > 0) {
+                length -= got;
+            }
+        }
+        return true;
+    };
+
+    if (!chunked_) {
+        return copy(size_) ? written : HTTPC_ERROR_READ_TIMEOUT;
+    }
+
+    std::string line;
+    while (readLine(line)) {
+        int chunkSize = static_cast<int>(strtol(line.c_str(), nullptr, 16));
+        if (chunkSize == 0) {
+            readLine(line);  // Trailing CRLF (no trailers expected)
+            return written;
+        }
+        if (!copy(chunkSize) || !readLine(line)) {
+            return HTTPC_ERROR_READ_TIMEOUT;
+        }
+    }
+    return HTTPC_ERROR_ENCODING;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#define HTTP_CODE_OK 200
+#define HTTP_CODE_NO_CONTENT 204
+#define HTTP_CODE_BAD_REQUEST 400
+#define HTTP_CODE_NOT_FOUND 404
+
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED (-2)
+#define HTTPC_ERROR_NOT_CONNECTED (-4)
+#define HTTPC_ERROR_CONNECTION_LOST (-5)
+#define HTTPC_ERROR_NO_HTTP_SERVER (-7)
+#define HTTPC_ERROR_ENCODING (-9)
+#define HTTPC_ERROR_STREAM_WRITE (-10)
+#define HTTPC_ERROR_READ_TIMEOUT (-11)
+
+/**
+ * The part of the ESP32 HTTPClient this project uses, for plain http:// URLs:
+ * keep-alive (setReuse), HTTP/1.0 requests, extra headers, collected response
+ * headers, Content-Length and chunked bodies. Error codes match the ESP32 core.
+ */
+class HTTPClient {
+ public:
+    bool begin(WiFiClient& client, const char* url);
+    void end();
+
+    void setReuse(bool reuse) { reuse_ = reuse; }
+    void useHTTP10(bool enabled) { http10_ = enabled; }
+    void setTimeout(uint16_t timeoutMs) { timeoutMs_ = timeoutMs; }
+    void addHeader(const char* name, const char* value);
+
+    /**
+     * Response headers to keep for header(), replaces the previous list
+     */
+    void collectHeaders(const char* headerKeys[], size_t headerKeysCount);
+    String header(const char* name) const;
+
+    int GET();
+
+    /**
+     * @return Content-Length of the response, -1 if not sent (chunked or until close)
+     */
+    int getSize() const { return size_; }
+
+    String getString();
+
+    /**
+     * Copy the body (de-chunked) to stream
+     * @return bytes written, or a negative HTTPC_ERROR code
+     */
+    int writeToStream(Stream* stream);
+
+    WiFiClient& getStream() { return *client_; }
+
+ private:
+    WiFiClient* client_ = nullptr;
+    std::string host_;
+    uint16_t port_ = 80;
+    std::string path_;
+    std::vector<std::pair<std::string, std::string>> headers_;
+    std::vector<std::pair<std::string, std::string>> responseHeaders_;  // Collected, by key
+
+    bool reuse_ = true;
+    bool http10_ = false;
+    uint16_t timeoutMs_ = 5000;
+
+    int size_ = -1;
+    bool chunked_ = false;
+    bool canReuse_ = false;  // Server keeps the connection open after this response
+
+    bool readLine(std::string& line);
+    int readResponseHeaders();
+};
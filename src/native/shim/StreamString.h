@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * String that can be written to and read from as a Stream, as in the ESP32
+ * core: reading consumes from the front.
+ */
+class StreamString : public Stream, public String {
+ public:
+    size_t write(uint8_t c) override { return concat(static_cast<char>(c)) ? 1 : 0; }
+    size_t write(const uint8_t* data, size_t size) override {
+        return concat(reinterpret_cast<const char*>(data), size) ? size : 0;
+    }
+
+    int available() override { return length(); }
+
+    int read() override {
+        if (length() == 0) {
+            return -1;
+        }
+        char c = charAt(0);
+        remove(0, 1);
+        return static_cast<uint8_t>(c);
+    }
+
+    int peek() override { return length() > 0 ? static_cast<uint8_t>(charAt(0)) : -1; }
+};
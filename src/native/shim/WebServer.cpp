@@ -0,0 +1,204 @@
+#include "WebServer.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+
+namespace {
+constexpr int kRequestTimeoutMs = 1000;
+constexpr size_t kMaxRequestBytes = 64 * 1024;
+
+const char* statusText(int code) {
+    switch (code) {
+        case 200:
+            return "OK";
+        case 204:
+            return "No Content";
+        case 400:
+            return "Bad Request";
+        case 404:
+            return "Not Found";
+        default:
+            return "";
+    }
+}
+
+std::string urlDecode(const std::string& text) {
+    std::string out;
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] == '+') {
+            out += ' ';
+        } else if (text[i] == '%' && i + 2 < text.size()) {
+            out += static_cast<char>(strtol(text.substr(i + 1, 2).c_str(), nullptr, 16));
+            i += 2;
+        } else {
+            out += text[i];
+        }
+    }
+    return out;
+}
+}  // namespace
+
+WebServer::~WebServer() {
+    if (listenFd_ >= 0) {
+        close(listenFd_);
+    }
+}
+
+void WebServer::begin() {
+    listenFd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    int reuse = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port_);
+    if (bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listenFd_, 4) < 0) {
+        Serial.printf("WebServer: cannot listen on port %d\n", port_);
+        close(listenFd_);
+        listenFd_ = -1;
+        return;
+    }
+    Serial.printf("WebServer: listening on port %d\n", port_);
+}
+
+void WebServer::handleClient() {
+    if (listenFd_ < 0) {
+        return;
+    }
+    clientFd_ = accept(listenFd_, nullptr, nullptr);
+    if (clientFd_ < 0) {
+        return;  // Nothing pending
+    }
+
+    if (readRequest()) {
+        responded_ = false;
+        bool routed = false;
+        for (const Route& route : routes_) {
+            if (route.uri == uri_ && (route.method == HTTP_ANY || route.method == method_)) {
+                route.handler();
+                routed = true;
+                break;
+            }
+        }
+        if (!routed && notFound_) {
+            notFound_();
+        }
+        if (!responded_) {
+            send(200, "text/plain", "");
+        }
+    }
+
+    close(clientFd_);
+    clientFd_ = -1;
+}
+
+bool WebServer::readRequest() {
+    std::string request;
+    size_t headerEnd = std::string::npos;
+    size_t contentLength = 0;
+    char buffer[2048];
+
+    while (request.size() < kMaxRequestBytes) {
+        if (headerEnd != std::string::npos && request.size() >= headerEnd + 4 + contentLength) {
+            break;
+        }
+        pollfd entry = {clientFd_, POLLIN, 0};
+        if (poll(&entry, 1, kRequestTimeoutMs) <= 0) {
+            return false;
+        }
+        ssize_t got = recv(clientFd_, buffer, sizeof(buffer), 0);
+        if (got <= 0) {
+            return false;
+        }
+        request.append(buffer, got);
+
+        if (headerEnd == std::string::npos) {
+            headerEnd = request.find("\r\n\r\n");
+            if (headerEnd != std::string::npos) {
+                std::string headers = request.substr(0, headerEnd);
+                for (char& c : headers) {
+                    c = static_cast<char>(tolower(c));
+                }
+                size_t field = headers.find("\r\ncontent-length:");
+                if (field != std::string::npos) {
+                    contentLength = strtoul(headers.c_str() + field + 17, nullptr, 10);
+                }
+            }
+        }
+    }
+    if (headerEnd == std::string::npos) {
+        return false;
+    }
+
+    // "POST /metrics/push?host=1 HTTP/1.1"
+    size_t methodEnd = request.find(' ');
+    size_t targetEnd = request.find(' ', methodEnd + 1);
+    if (methodEnd == std::string::npos || targetEnd == std::string::npos) {
+        return false;
+    }
+    std::string method = request.substr(0, methodEnd);
+    method_ = method == "POST"     ? HTTP_POST
+              : method == "PUT"    ? HTTP_PUT
+              : method == "DELETE" ? HTTP_DELETE
+                                   : HTTP_GET;
+
+    std::string target = request.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    size_t question = target.find('?');
+    uri_ = target.substr(0, question);
+    args_.clear();
+    if (question != std::string::npos) {
+        parseQuery(target.substr(question + 1));
+    }
+
+    std::string body = request.substr(headerEnd + 4, contentLength);
+    if (method_ != HTTP_GET && !body.empty()) {
+        args_["plain"] = body;
+    }
+    return true;
+}
+
+void WebServer::parseQuery(const std::string& query) {
+    size_t start = 0;
+    while (start <= query.size()) {
+        size_t end = query.find('&', start);
+        std::string pair = query.substr(start, end - start);
+        size_t equals = pair.find('=');
+        if (!pair.empty()) {
+            args_[urlDecode(pair.substr(0, equals))] =
+                equals == std::string::npos ? "" : urlDecode(pair.substr(equals + 1));
+        }
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+}
+
+String WebServer::arg(const String& name) const {
+    auto entry = args_.find(name.c_str());
+    return entry != args_.end() ? String(entry->second.c_str()) : String();
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+    if (clientFd_ < 0 || responded_) {
+        return;
+    }
+    responded_ = true;
+
+    char header[256];
+    int length = snprintf(header, sizeof(header),
+                          "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %u\r\n"
+                          "Connection: close\r\n\r\n",
+                          code, statusText(code), contentType, content.length());
+    ::send(clientFd_, header, length, MSG_NOSIGNAL);
+    ::send(clientFd_, content.c_str(), content.length(), MSG_NOSIGNAL);
+}
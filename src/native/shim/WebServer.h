@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_POST, HTTP_PUT, HTTP_DELETE };
+
+/**
+ * Synchronous HTTP server with the ESP32 WebServer interface: handleClient()
+ * serves at most one pending connection per call and closes it afterwards.
+ * Privileged ports are moved up by 8000 (80 becomes 8080) so the process
+ * does not need root.
+ */
+class WebServer {
+ public:
+    using Handler = std::function<void()>;
+
+    explicit WebServer(int port = 80) : port_(port < 1024 ? port + 8000 : port) {}
+    ~WebServer();
+
+    WebServer(const WebServer&) = delete;
+    WebServer& operator=(const WebServer&) = delete;
+
+    void on(const char* uri, Handler handler) { on(uri, HTTP_ANY, std::move(handler)); }
+    void on(const char* uri, HTTPMethod method, Handler handler) {
+        routes_.push_back({uri, method, std::move(handler)});
+    }
+    void onNotFound(Handler handler) { notFound_ = std::move(handler); }
+
+    void begin();
+    void handleClient();
+
+    void send(int code, const char* contentType = "", const String& content = String());
+    void send(int code, const String& contentType, const String& content) {
+        send(code, contentType.c_str(), content);
+    }
+
+    /**
+     * Query arguments, and "plain" for the body of a POST
+     */
+    bool hasArg(const String& name) const { return args_.count(name.c_str()) > 0; }
+    String arg(const String& name) const;
+    String uri() const { return uri_.c_str(); }
+    HTTPMethod method() const { return method_; }
+
+ private:
+    struct Route {
+        std::string uri;
+        HTTPMethod method;
+        Handler handler;
+    };
+
+    int port_;
+    int listenFd_ = -1;
+    int clientFd_ = -1;
+    std::vector<Route> routes_;
+    Handler notFound_;
+
+    // Current request
+    std::string uri_;
+    HTTPMethod method_ = HTTP_GET;
+    std::map<std::string, std::string> args_;
+    bool responded_ = false;
+
+    bool readRequest();
+    void parseQuery(const std::string& query);
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+
+#include <cstdio>
+
+enum wl_status_t { WL_IDLE_STATUS = 0, WL_CONNECTED = 3, WL_DISCONNECTED = 6 };
+
+class IPAddress {
+ public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : bytes_{a, b, c, d} {}
+
+    String toString() const {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", bytes_[0], bytes_[1], bytes_[2], bytes_[3]);
+        return String(static_cast<const char*>(text));
+    }
+
+ private:
+    uint8_t bytes_[4];
+};
+
+/**
+ * The host network is up before the process starts: the station reports
+ * connected to loopback as soon as begin() is called.
+ */
+class WiFiClass {
+ public:
+    void begin(const char*, const char* = nullptr) { status_ = WL_CONNECTED; }
+    void disconnect() { status_ = WL_DISCONNECTED; }
+    wl_status_t status() const { return status_; }
+    bool isConnected() const { return status_ == WL_CONNECTED; }
+    IPAddress localIP() const { return IPAddress(127, 0, 0, 1); }
+    int8_t RSSI() const { return 0; }
+    String macAddress() const { return "00:00:00:00:00:00"; }
+    bool setHostname(const char*) { return true; }
+
+ private:
+    wl_status_t status_ = WL_IDLE_STATUS;
+};
+
+inline WiFiClass WiFi;
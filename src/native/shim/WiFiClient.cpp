@@ -0,0 +1,149 @@
+#include "WiFiClient.h"
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace {
+bool waitReady(int fd, short events, int timeoutMs) {
+    pollfd entry = {fd, events, 0};
+    return poll(&entry, 1, timeoutMs) > 0 && (entry.revents & (events | POLLHUP | POLLERR));
+}
+}  // namespace
+
+int WiFiClient::connect(const char* host, uint16_t port, int32_t timeoutMs) {
+    stop();
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    char service[8];
+    snprintf(service, sizeof(service), "%u", port);
+    if (getaddrinfo(host, service, &hints, &addresses) != 0) {
+        return 0;
+    }
+
+    for (addrinfo* address = addresses; address != nullptr && fd_ < 0;
+         address = address->ai_next) {
+        int fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+
+        // Non-blocking connect, so the timeout applies
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        int result = ::connect(fd, address->ai_addr, address->ai_addrlen);
+        if (result < 0 && errno == EINPROGRESS && waitReady(fd, POLLOUT, timeoutMs)) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+            result = error == 0 ? 0 : -1;
+        }
+        fcntl(fd, F_SETFL, flags);
+
+        if (result == 0) {
+            fd_ = fd;
+        } else {
+            close(fd);
+        }
+    }
+    freeaddrinfo(addresses);
+
+    bufferPos_ = bufferLen_ = 0;
+    return fd_ >= 0 ? 1 : 0;
+}
+
+bool WiFiClient::connected() {
+    if (fd_ < 0) {
+        return false;
+    }
+    if (bufferPos_ < bufferLen_) {
+        return true;
+    }
+    uint8_t probe;
+    ssize_t result = recv(fd_, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (result == 0 || (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+        stop();  // Closed by the peer
+        return false;
+    }
+    return true;
+}
+
+void WiFiClient::stop() {
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    bufferPos_ = bufferLen_ = 0;
+}
+
+void WiFiClient::setNoDelay(bool enabled) {
+    if (fd_ >= 0) {
+        int value = enabled ? 1 : 0;
+        setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+    }
+}
+
+size_t WiFiClient::write(const uint8_t* data, size_t size) {
+    size_t sent = 0;
+    while (fd_ >= 0 && sent < size) {
+        ssize_t result = send(fd_, data + sent, size - sent, MSG_NOSIGNAL);
+        if (result <= 0) {
+            break;
+        }
+        sent += result;
+    }
+    return sent;
+}
+
+bool WiFiClient::fill(int waitMs) {
+    if (bufferPos_ < bufferLen_) {
+        return true;
+    }
+    if (fd_ < 0 || (waitMs > 0 && !waitReady(fd_, POLLIN, waitMs))) {
+        return false;
+    }
+    ssize_t result = recv(fd_, buffer_, kBufferSize, MSG_DONTWAIT);
+    if (result <= 0) {
+        return false;
+    }
+    bufferPos_ = 0;
+    bufferLen_ = result;
+    return true;
+}
+
+int WiFiClient::available() {
+    int pending = 0;
+    if (fd_ >= 0) {
+        ioctl(fd_, FIONREAD, &pending);
+    }
+    return static_cast<int>(bufferLen_ - bufferPos_) + pending;
+}
+
+int WiFiClient::read() {
+    return fill(0) ? buffer_[bufferPos_++] : -1;
+}
+
+int WiFiClient::peek() {
+    return fill(0) ? buffer_[bufferPos_] : -1;
+}
+
+size_t WiFiClient::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length && fill(static_cast<int>(timeout_))) {
+        size_t chunk = std::min(length - count, bufferLen_ - bufferPos_);
+        memcpy(buffer + count, buffer_ + bufferPos_, chunk);
+        bufferPos_ += chunk;
+        count += chunk;
+    }
+    return count;
+}
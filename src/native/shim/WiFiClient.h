@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * TCP client over a POSIX socket, with the blocking-read-with-timeout
+ * behaviour of the ESP32 WiFiClient. Reads go through a small buffer.
+ */
+class WiFiClient : public Stream {
+ public:
+    WiFiClient() = default;
+    ~WiFiClient() override { stop(); }
+
+    WiFiClient(const WiFiClient&) = delete;
+    WiFiClient& operator=(const WiFiClient&) = delete;
+
+    /**
+     * @return 1 when connected, 0 on failure (as the Arduino API)
+     */
+    int connect(const char* host, uint16_t port, int32_t timeoutMs = 3000);
+    bool connected();
+    void stop();
+    void setNoDelay(bool enabled);
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* data, size_t size) override;
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char* buffer, size_t length) override;
+
+ private:
+    static constexpr size_t kBufferSize = 4096;
+
+    int fd_ = -1;
+    uint8_t buffer_[kBufferSize];
+    size_t bufferPos_ = 0;
+    size_t bufferLen_ = 0;
+
+    /**
+     * Refill an empty buffer, waiting up to waitMs for data
+     * @return false if nothing arrived or the connection is gone
+     */
+    bool fill(int waitMs);
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+/**
+ * Capability-based heap of ESP-IDF for the native environments. There is
+ * one kind of memory here, so every capability maps to malloc.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+inline void* heap_caps_malloc(size_t size, uint32_t) {
+    return malloc(size);
+}
+
+inline void* heap_caps_realloc(void* ptr, size_t size, uint32_t) {
+    return realloc(ptr, size);
+}
+
+inline void heap_caps_free(void* ptr) {
+    free(ptr);
+}
+
+inline size_t heap_caps_get_free_size(uint32_t) {
+    return 2 * 1024 * 1024;  // No real limit here, report the board's PSRAM
+}
+
+inline size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    return heap_caps_get_free_size(caps);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+using esp_err_t = int;
+
+#define ESP_OK 0
+#define ESP_FAIL (-1)
+
+enum esp_reset_reason_t {
+    ESP_RST_UNKNOWN,
+    ESP_RST_POWERON,
+    ESP_RST_EXT,
+    ESP_RST_SW,
+    ESP_RST_PANIC,
+    ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT,
+    ESP_RST_WDT,
+    ESP_RST_DEEPSLEEP,
+    ESP_RST_BROWNOUT,
+    ESP_RST_SDIO,
+};
+
+/**
+ * A host process always starts from power on
+ */
+inline esp_reset_reason_t esp_reset_reason() {
+    return ESP_RST_POWERON;
+}
+
+inline const char* esp_err_to_name(esp_err_t error) {
+    return error == ESP_OK ? "ESP_OK" : "ESP_FAIL";
+}
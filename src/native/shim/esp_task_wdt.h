@@ -0,0 +1,29 @@
+#pragma once
+
+/**
+ * Task watchdog of ESP-IDF for the native environments. Nothing is watched:
+ * a stalled task shows up in a debugger or profiler instead of a reset.
+ */
+
+#include "esp_system.h"
+#include "freertos/task.h"
+
+inline esp_err_t esp_task_wdt_init(uint32_t, bool) {
+    return ESP_OK;
+}
+
+inline esp_err_t esp_task_wdt_add(TaskHandle_t) {
+    return ESP_OK;
+}
+
+inline esp_err_t esp_task_wdt_delete(TaskHandle_t) {
+    return ESP_OK;
+}
+
+inline esp_err_t esp_task_wdt_reset() {
+    return ESP_OK;
+}
+
+inline esp_err_t esp_task_wdt_status(TaskHandle_t) {
+    return ESP_OK;
+}
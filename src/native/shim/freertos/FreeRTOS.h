@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * FreeRTOS for the native environments, on top of POSIX threads. Time is
+ * counted in milliseconds (one tick per ms); priorities and core affinity
+ * are accepted and ignored, the Linux scheduler decides.
+ */
+
+#include <cstdint>
+
+using TickType_t = uint32_t;
+using BaseType_t = int;
+using UBaseType_t = unsigned int;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY (-1)
+#define portMAX_DELAY 0xFFFFFFFFu
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms))
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define ARDUINO_RUNNING_CORE 1
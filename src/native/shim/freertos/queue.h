@@ -0,0 +1,17 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+struct NativeQueue;
+using QueueHandle_t = NativeQueue*;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void vQueueDelete(QueueHandle_t queue);
+
+/**
+ * Copy itemSize bytes from item to the back of the queue, waiting up to
+ * ticks for space
+ */
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* outItem, TickType_t ticks);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
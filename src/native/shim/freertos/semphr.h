@@ -0,0 +1,18 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+struct NativeSemaphore;
+using SemaphoreHandle_t = NativeSemaphore*;
+
+/**
+ * Mutexes are binary semaphores that start given; like FreeRTOS mutexes
+ * they are not recursive
+ */
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary();
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount);
+void vSemaphoreDelete(SemaphoreHandle_t semaphore);
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+struct NativeTask;
+using TaskHandle_t = NativeTask*;
+using TaskFunction_t = void (*)(void*);
+
+/**
+ * Runs taskFunction on a new thread named taskName. The stack is sized in
+ * bytes as on the ESP32, scaled up for 64-bit code.
+ */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t taskFunction, const char* taskName,
+                                   uint32_t stackSize, void* parameter, UBaseType_t priority,
+                                   TaskHandle_t* outHandle, BaseType_t coreId);
+
+BaseType_t xTaskCreate(TaskFunction_t taskFunction, const char* taskName, uint32_t stackSize,
+                       void* parameter, UBaseType_t priority, TaskHandle_t* outHandle);
+
+/**
+ * Ends the task, the calling one for nullptr
+ */
+void vTaskDelete(TaskHandle_t task);
+
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t period);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+/**
+ * Not measured on the host, always 0. On the device 0 means the stack ran
+ * out; here it only means unknown, so look at the stack with the host tools.
+ */
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+/**
+ * Direct to task notifications, used as a counting semaphore. Take waits for
+ * the calling task's count to be non-zero and returns it, 0 on timeout.
+ */
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
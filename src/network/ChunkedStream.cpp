@@ -0,0 +1,113 @@
+#include "ChunkedStream.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+int ChunkedStream::available() {
+    // Only parse framing that has already arrived, available() must not block
+    if (remaining_ == 0 && (inner_.available() == 0 || !nextPayload())) {
+        return 0;
+    }
+    return std::min<size_t>(remaining_, inner_.available());
+}
+
+int ChunkedStream::read() {
+    if (!nextPayload()) {
+        return -1;
+    }
+    int c = inner_.read();
+    if (c >= 0) {
+        remaining_--;
+    }
+    return c;
+}
+
+int ChunkedStream::peek() {
+    return nextPayload() ? inner_.peek() : -1;
+}
+
+size_t ChunkedStream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length && nextPayload()) {
+        size_t got = inner_.readBytes(buffer + count, std::min(length - count, remaining_));
+        if (got == 0) {
+            break;  // Timed out, or the inner stream's deadline passed
+        }
+        remaining_ -= got;
+        count += got;
+    }
+    return count;
+}
+
+bool ChunkedStream::finish() {
+    char buffer[128];
+    while (nextPayload()) {
+        if (readBytes(buffer, sizeof(buffer)) == 0) {
+            return false;
+        }
+    }
+    return finished();
+}
+
+bool ChunkedStream::nextPayload() {
+    char line[MAX_LINE];
+    while (remaining_ == 0) {
+        switch (state_) {
+            case State::DATA:
+                state_ = State::DATA_END;
+                break;
+            case State::DATA_END:
+                // CRLF closing the chunk's data
+                state_ = readLine(line) && line[0] == '\0' ? State::SIZE : State::FAILED;
+                break;
+            case State::SIZE: {
+                if (!readLine(line)) {
+                    state_ = State::FAILED;
+                    break;
+                }
+                // Hex size, optionally followed by ";extension"
+                char* end = nullptr;
+                unsigned long size = strtoul(line, &end, 16);
+                if (end == line || (*end != '\0' && *end != ';' && *end != ' ')) {
+                    state_ = State::FAILED;
+                } else if (size == 0) {
+                    state_ = State::TRAILER;
+                } else {
+                    remaining_ = size;
+                    state_ = State::DATA;
+                }
+                break;
+            }
+            case State::TRAILER:
+                // Trailer fields until an empty line
+                if (!readLine(line)) {
+                    state_ = State::FAILED;
+                } else if (line[0] == '\0') {
+                    state_ = State::DONE;
+                }
+                break;
+            case State::DONE:
+            case State::FAILED:
+                return false;
+        }
+    }
+    return true;
+}
+
+bool ChunkedStream::readLine(char (&line)[MAX_LINE]) {
+    size_t length = 0;
+    char c;
+    while (inner_.readBytes(&c, 1) == 1) {
+        if (c == '\n') {
+            if (length > 0 && line[length - 1] == '\r') {
+                length--;
+            }
+            line[length] = '\0';
+            return true;
+        }
+        if (length < MAX_LINE - 1) {
+            line[length++] = c;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Payload of a chunked HTTP/1.1 body, read through from the socket. Chunk
+ * sizes, extensions and trailers are consumed on the way, so a parser only
+ * sees the payload and ends at the terminating chunk. Reads go to the inner
+ * stream, so a DeadlineStream there stops them with the fetch budget. A
+ * malformed chunk header ends the body early with failed() set.
+ */
+class ChunkedStream : public Stream {
+ public:
+    explicit ChunkedStream(Stream& inner) : inner_(inner) { setTimeout(inner.getTimeout()); }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char* buffer, size_t length) override;
+
+    using Print::write;
+    size_t write(uint8_t) override { return 0; }
+
+    /**
+     * Read past whatever the consumer left, up to the end of the body, so the
+     * next response on a kept-alive socket starts where it should
+     * @return true once the terminating chunk and trailers have been read
+     */
+    bool finish();
+
+    bool finished() const { return state_ == State::DONE; }
+    bool failed() const { return state_ == State::FAILED; }
+
+ private:
+    enum class State : uint8_t { SIZE, DATA, DATA_END, TRAILER, DONE, FAILED };
+
+    static constexpr size_t MAX_LINE = 64;  // Longer lines (extensions, trailers) are cut
+
+    // Moves through chunk framing until payload is available or the body ends
+    bool nextPayload();
+    bool readLine(char (&line)[MAX_LINE]);
+
+    Stream& inner_;
+    State state_ = State::SIZE;
+    size_t remaining_ = 0;  // Payload bytes left in the current chunk
+};
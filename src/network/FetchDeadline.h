@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <algorithm>
+
+/**
+ * Time budget of one fetch, shared by its connect, request, retries and body
+ */
+class FetchDeadline {
+ public:
+    explicit FetchDeadline(uint32_t budgetMs) : startMs_(millis()), budgetMs_(budgetMs) {}
+
+    uint32_t elapsedMs() const { return millis() - startMs_; }
+    uint32_t remainingMs() const { return budgetMs_ - std::min(elapsedMs(), budgetMs_); }
+    bool expired() const { return remainingMs() == 0; }
+
+ private:
+    unsigned long startMs_;
+    uint32_t budgetMs_;
+};
+
+/**
+ * Stream over another one that ends when the deadline passes: reads wait at
+ * most the time left, and once it is spent reads return nothing and writes
+ * are refused. Parsers reading from it then fail with incomplete input
+ * instead of blocking on a host that went quiet. The bytes read through it
+ * are counted, so a caller can tell how much of a body was left.
+ */
+class DeadlineStream : public Stream {
+ public:
+    DeadlineStream(Stream& inner, const FetchDeadline& deadline)
+        : inner_(inner), deadline_(deadline), innerTimeout_(inner.getTimeout()) {}
+    ~DeadlineStream() { inner_.setTimeout(innerTimeout_); }
+
+    int available() override { return checkDeadline() ? inner_.available() : 0; }
+    int read() override {
+        int c = checkDeadline() ? inner_.read() : -1;
+        bytesRead_ += c >= 0 ? 1 : 0;
+        return c;
+    }
+    int peek() override { return checkDeadline() ? inner_.peek() : -1; }
+
+    size_t readBytes(char* buffer, size_t length) override {
+        if (!checkDeadline()) {
+            return 0;
+        }
+        inner_.setTimeout(std::min<unsigned long>(innerTimeout_, deadline_.remainingMs()));
+        size_t got = inner_.readBytes(buffer, length);
+        bytesRead_ += got;
+        return got;
+    }
+
+    using Print::write;
+    size_t write(uint8_t c) override { return checkDeadline() ? inner_.write(c) : 0; }
+    size_t write(const uint8_t* data, size_t size) override {
+        return checkDeadline() ? inner_.write(data, size) : 0;
+    }
+
+    bool cancelled() const { return cancelled_; }
+    size_t bytesRead() const { return bytesRead_; }
+
+ private:
+    bool checkDeadline() {
+        cancelled_ = cancelled_ || deadline_.expired();
+        return !cancelled_;
+    }
+
+    Stream& inner_;
+    const FetchDeadline& deadline_;
+    unsigned long innerTimeout_;
+    bool cancelled_ = false;
+    size_t bytesRead_ = 0;
+};
@@ -1,32 +1,254 @@
 #include "HttpClient.h"
 
-HttpClient::HttpClient() {}
+#include <StreamString.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "network/ChunkedStream.h"
+
+namespace {
+const char* RESPONSE_HEADERS[] = {"Transfer-Encoding"};
+
+// "http://host:port/path" to host and port
+bool parseServer(const char* url, String& host, uint16_t& port) {
+    const char* start = strstr(url, "://");
+    if (start == nullptr) {
+        return false;
+    }
+    start += 3;
+    const char* end = start + strcspn(start, "/?");
+    const char* colon = static_cast<const char*>(memchr(start, ':', end - start));
+
+    host = String();
+    host.concat(start, (colon != nullptr ? colon : end) - start);
+    port = colon != nullptr ? atoi(colon + 1) : (strncmp(url, "https", 5) == 0 ? 443 : 80);
+    return host.length() > 0;
+}
+
+// Reads and drops count bytes, false if the stream ends first
+bool skip(Stream& stream, size_t count) {
+    char buffer[64];
+    while (count > 0) {
+        size_t got = stream.readBytes(buffer, std::min(count, sizeof(buffer)));
+        if (got == 0) {
+            return false;
+        }
+        count -= got;
+    }
+    return true;
+}
+}  // namespace
+
+HttpClient::HttpClient() {
+    http_.setReuse(keepAlive_);
+}
 
 HttpClient::~HttpClient() {
     http_.end();
+    client_.stop();
+}
+
+void HttpClient::setKeepAlive(bool enabled) {
+    keepAlive_ = enabled;
+    http_.setReuse(enabled);
+    if (!enabled) {
+        client_.stop();
+    }
+}
+
+void HttpClient::beginRequest(const char* url) {
+    http_.begin(client_, url);
+    // begin() clears the headers of the previous request
+    if (accept_ != nullptr) {
+        http_.addHeader("Accept", accept_);
+    }
+    http_.collectHeaders(RESPONSE_HEADERS, sizeof(RESPONSE_HEADERS) / sizeof(RESPONSE_HEADERS[0]));
+}
+
+int HttpClient::sendGet(const char* url, const FetchDeadline& deadline) {
+    unsigned long startTime = millis();
+    lastRequest_ = RequestInfo();
+
+    // HTTPClient sends over any open socket, even one to another server
+    String host;
+    uint16_t port;
+    if (!parseServer(url, host, port)) {
+        return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+    String server = host + ":" + String(port);
+    if (server != connectedServer_) {
+        client_.stop();
+        connectedServer_ = server;
+    }
+
+    lastRequest_.reusedConnection = keepAlive_ && client_.connected();
+    int httpCode = connectAndGet(url, deadline);
+
+    // The server may have closed the kept-alive socket since the last request
+    if (lastRequest_.reusedConnection && httpCode < 0 && !deadline.expired()) {
+        http_.end();
+        client_.stop();
+        lastRequest_.reusedConnection = false;
+        lastRequest_.reconnected = true;
+        httpCode = connectAndGet(url, deadline);
+    }
+
+    lastRequest_.timeMs = millis() - startTime;
+    lastRequest_.contentLength = httpCode > 0 ? http_.getSize() : -1;
+    lastRequest_.cancelled = httpCode < 0 && deadline.expired();
+    return httpCode;
+}
+
+int HttpClient::connectAndGet(const char* url, const FetchDeadline& deadline) {
+    // Connecting here rather than in GET() times it separately, HTTPClient
+    // sends over the socket it finds open
+    if (!client_.connected()) {
+        String host;
+        uint16_t port;
+        parseServer(url, host, port);
+
+        unsigned long connectStart = millis();
+        bool connected = !deadline.expired() &&
+                         client_.connect(host.c_str(), port, deadline.remainingMs()) != 0;
+        lastRequest_.connectMs += millis() - connectStart;
+        if (!connected) {
+            return HTTPC_ERROR_CONNECTION_REFUSED;
+        }
+    }
+
+    unsigned long requestStart = millis();
+    beginRequest(url);
+    http_.setTimeout(std::min<uint32_t>(deadline.remainingMs(), UINT16_MAX));
+    int httpCode = http_.GET();
+    lastRequest_.ttfbMs += millis() - requestStart;
+    return httpCode;
+}
+
+bool HttpClient::readBody(Stream& out, const FetchDeadline& deadline) {
+    unsigned long transferStart = millis();
+    bool success;
+
+    int size = http_.getSize();
+    if (size < 0) {
+        // Chunked or until close: HTTPClient de-chunks, the deadline only stops
+        // it between blocks
+        DeadlineStream sink(out, deadline);
+        success = http_.writeToStream(&sink) >= 0;
+        lastRequest_.cancelled = sink.cancelled();
+    } else {
+        DeadlineStream body(http_.getStream(), deadline);
+        char buffer[512];
+        while (size > 0) {
+            size_t got = body.readBytes(buffer, std::min<size_t>(size, sizeof(buffer)));
+            if (got == 0 || out.write(reinterpret_cast<uint8_t*>(buffer), got) != got) {
+                break;
+            }
+            size -= got;
+        }
+        success = size == 0;
+        lastRequest_.cancelled = body.cancelled();
+    }
+
+    lastRequest_.transferMs = millis() - transferStart;
+    if (!success) {
+        client_.stop();  // The rest of the body would be read as the next response
+    }
+    return success;
+}
+
+bool HttpClient::waitBeforeRetry(uint32_t retryDelayMs, const FetchDeadline& deadline) {
+    if (deadline.remainingMs() <= retryDelayMs) {
+        return false;  // No time left for another attempt
+    }
+    vTaskDelay(pdMS_TO_TICKS(retryDelayMs));
+    return true;
 }
 
 bool HttpClient::download(const char* url, String& outResponse, uint8_t maxRetries,
                           uint32_t retryDelayMs) {
+    StreamString body;
+    if (!downloadInto(url, body, maxRetries, retryDelayMs)) {
+        return false;
+    }
+    outResponse = std::move(body);
+    return true;
+}
+
+bool HttpClient::downloadInto(const char* url, StreamString& outBody, uint8_t maxRetries,
+                              uint32_t retryDelayMs) {
+    FetchDeadline deadline(fetchBudgetMs_);
     bool success = false;
-    uint8_t retryCount = 0;
     lastHttpCode_ = 0;
 
-    while (retryCount < maxRetries && !success) {
-        http_.begin(url);
-        lastHttpCode_ = http_.GET();
+    for (uint8_t attempt = 1; attempt <= maxRetries; attempt++) {
+        lastHttpCode_ = sendGet(url, deadline);
 
         if (lastHttpCode_ == HTTP_CODE_OK) {
-            outResponse = http_.getString();
-            success = true;
-        } else {
-            retryCount++;
-            if (retryCount < maxRetries) {
-                vTaskDelay(pdMS_TO_TICKS(retryDelayMs));
+            outBody.remove(0);  // Drops the content, keeps the allocation
+            int size = http_.getSize();
+            if (size > 0) {
+                outBody.reserve(size);
             }
+            success = readBody(outBody, deadline);
+            http_.end();
+            break;  // Body was consumed, a retry would mean a second download
         }
+
         http_.end();
+        if (attempt == maxRetries || !waitBeforeRetry(retryDelayMs, deadline)) {
+            break;
+        }
     }
 
     return success;
-}
\ No newline at end of file
+}
+
+bool HttpClient::downloadStream(const char* url, const StreamHandler& handler,
+                                uint8_t maxRetries, uint32_t retryDelayMs) {
+    FetchDeadline deadline(fetchBudgetMs_);
+    bool success = false;
+    lastHttpCode_ = 0;
+
+    // Without keep-alive HTTP/1.0 keeps the server from chunking at all, with it a
+    // chunked body is de-chunked on the way to the handler
+    http_.useHTTP10(!keepAlive_);
+
+    for (uint8_t attempt = 1; attempt <= maxRetries; attempt++) {
+        lastHttpCode_ = sendGet(url, deadline);
+
+        if (lastHttpCode_ == HTTP_CODE_OK) {
+            unsigned long transferStart = millis();
+            DeadlineStream socket(http_.getStream(), deadline);
+            bool complete;
+            // A parser stops at the end of the document, before the last chunk
+            // or any bytes that trail it within the length
+            if (http_.header(RESPONSE_HEADERS[0]).equalsIgnoreCase("chunked")) {
+                ChunkedStream body(socket);
+                success = handler(body);
+                complete = success && body.finish();
+            } else {
+                int size = http_.getSize();  // -1 until close, which ends the socket
+                success = handler(socket);
+                complete = success && size >= 0 && socket.bytesRead() <= size_t(size) &&
+                           skip(socket, size - socket.bytesRead());
+            }
+            lastRequest_.transferMs = millis() - transferStart;
+            lastRequest_.cancelled = socket.cancelled();
+            if (!complete) {
+                client_.stop();  // Whatever the handler left unread is still coming
+            }
+            http_.end();
+            break;  // Body was consumed, a retry would mean a second download
+        }
+
+        http_.end();
+        if (attempt == maxRetries || !waitBeforeRetry(retryDelayMs, deadline)) {
+            break;
+        }
+    }
+
+    http_.useHTTP10(false);
+    return success;
+}
@@ -1,19 +1,93 @@
 #pragma once
 
 #include <HTTPClient.h>
+#include <StreamString.h>
 #include <WiFiClient.h>
 
+#include <functional>
+
+#include "network/FetchDeadline.h"
+
 class HttpClient {
  public:
+    // Consumes the response body directly from the socket. Returns false to
+    // signal that the body could not be processed (no retry is attempted).
+    using StreamHandler = std::function<bool(Stream& body)>;
+
+    // Details of the most recent GET
+    struct RequestInfo {
+        uint32_t timeMs = 0;            // Connect (if any) + request + time to headers
+        uint32_t connectMs = 0;         // TCP connect, 0 over a kept-alive socket
+        uint32_t ttfbMs = 0;            // Request sent to response headers read
+        uint32_t transferMs = 0;        // Body, including the handler when streamed
+        bool reusedConnection = false;  // Sent over a kept-alive socket
+        bool reconnected = false;       // Kept-alive socket was found closed and reopened
+        bool cancelled = false;         // The fetch budget ran out before the body was read
+        int contentLength = -1;         // From the response headers, -1 if not sent
+    };
+
     HttpClient();
     ~HttpClient();
 
+    /**
+     * Keep the TCP connection open between requests (HTTP/1.1 keep-alive).
+     * A socket closed by the server is detected and reopened transparently.
+     */
+    void setKeepAlive(bool enabled);
+    bool isKeepAlive() const { return keepAlive_; }
+
+    /**
+     * Accept header sent with every request, nullptr for none. The string must
+     * outlive the client.
+     */
+    void setAccept(const char* accept) { accept_ = accept; }
+
+    /**
+     * Longest a download may take in total: connect, request, retries and
+     * body. What is still pending when it runs out is cancelled and the
+     * download fails.
+     */
+    void setFetchBudget(uint32_t budgetMs) { fetchBudgetMs_ = budgetMs; }
+
     bool download(const char* url, String& outResponse, uint8_t maxRetries = 2,
                   uint32_t retryDelayMs = 100);
 
+    /**
+     * Like download(), but writes the body into an existing buffer. The buffer
+     * keeps its capacity between calls, so a reused buffer stops allocating
+     * once it has grown to the usual response size.
+     */
+    bool downloadInto(const char* url, StreamString& outBody, uint8_t maxRetries = 2,
+                      uint32_t retryDelayMs = 100);
+
+    /**
+     * GET the url and hand the raw body stream to the handler instead of
+     * buffering it into a String. Without keep-alive the request is sent as
+     * HTTP/1.0 so the server never answers with chunked transfer encoding;
+     * with keep-alive a chunked body is de-chunked as the handler reads it.
+     */
+    bool downloadStream(const char* url, const StreamHandler& handler, uint8_t maxRetries = 2,
+                        uint32_t retryDelayMs = 100);
+
     int getLastHttpCode() const { return lastHttpCode_; }
+    const RequestInfo& getLastRequest() const { return lastRequest_; }
 
  private:
+    static constexpr uint32_t DEFAULT_FETCH_BUDGET_MS = 5000;
+
+    void beginRequest(const char* url);
+    int sendGet(const char* url, const FetchDeadline& deadline);
+    int connectAndGet(const char* url, const FetchDeadline& deadline);
+    bool readBody(Stream& out, const FetchDeadline& deadline);
+    bool waitBeforeRetry(uint32_t retryDelayMs, const FetchDeadline& deadline);
+
+    // Declared before http_, which may still reference it while being destroyed
+    WiFiClient client_;
     HTTPClient http_;
+    bool keepAlive_ = false;
+    const char* accept_ = nullptr;
+    uint32_t fetchBudgetMs_ = DEFAULT_FETCH_BUDGET_MS;
+    String connectedServer_;  // "host:port" the socket was opened to
     int lastHttpCode_ = 0;
-};
\ No newline at end of file
+    RequestInfo lastRequest_;
+};
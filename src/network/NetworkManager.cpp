@@ -2,7 +2,9 @@
 
 NetworkManager::NetworkManager(LoggerInterface& logger, HttpClient& httpClient,
                                AppConfigInterface& config)
-    : logger_(logger), httpClient_(httpClient), config_(config) {}
+    : logger_(logger), httpClient_(httpClient), config_(config) {
+    httpClient_.setKeepAlive(config_.getHardwareMonitorKeepAlive());
+}
 
 bool NetworkManager::connect() {
     WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
@@ -33,12 +35,10 @@ String NetworkManager::get(const String& url) {
     if (!isConnected_)
         return "";
 
-    HTTPClient http;
-    http.begin(url);
-    int httpCode = http.GET();
-
-    if (httpCode == HTTP_CODE_OK) {
-        return http.getString();
+    // Shares the HttpClient so requests reuse its connection when keep-alive is on
+    String response;
+    if (httpClient_.download(url.c_str(), response, 1)) {
+        return response;
     }
     return "";
 }
\ No newline at end of file
@@ -1,12 +1,39 @@
 #include "WebServerService.h"
 
-WebServerService::WebServerService(UiController& uiController, ApplicationMetrics& systemMetrics)
-    : server_(80), uiController_(uiController), systemMetrics_(systemMetrics) {}
+#include <stdarg.h>
+
+#include <algorithm>
+
+namespace {
+// printf onto the end of out, a line at a time; a line longer than the buffer is cut short
+void appendf(String& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+void appendf(String& out, const char* format, ...) {
+    char line[192];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length > 0) {
+        out.concat(line, std::min<size_t>(length, sizeof(line) - 1));
+    }
+}
+}  // namespace
+
+WebServerService::WebServerService(UiController& uiController, ApplicationMetrics& systemMetrics,
+                                   PcMetricsHosts& pcMetricsHosts,
+                                   PcMetricsPushReceiver& pushReceiver)
+    : server_(80),
+      uiController_(uiController),
+      systemMetrics_(systemMetrics),
+      pcMetricsHosts_(pcMetricsHosts),
+      pushReceiver_(pushReceiver) {}
 
 void WebServerService::begin() {
     server_.on("/", [this]() { this->handleHome(); });
     server_.on("/system-info", [this]() { this->handleSystemInfo(); });
     server_.on("/app-info", [this]() { this->handleAppInfo(); });
+    server_.on("/metrics/push", HTTP_POST, [this]() { this->handleMetricsPush(); });
     server_.on("/screen/main", [this]() { uiController_.requestScreen(ScreenName::MAIN); });
     server_.on("/screen/settings", [this]() { uiController_.requestScreen(ScreenName::SETTINGS); });
     server_.onNotFound([this]() { this->handleNotFound(); });
@@ -26,73 +53,130 @@ void WebServerService::handleHome() {
 }
 
 String WebServerService::getSystemInfo() {
-    char buffer[300];
-    size_t offset = 0;
+    String info;
+    info.reserve(300);
 
     // Write opening tag
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "<pre>");
+    appendf(info, "<pre>");
 
     // CPU Frequency
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "CPU Frequency: %u MHz\n",
-                       ESP.getCpuFreqMHz());
+    appendf(info, "CPU Frequency: %u MHz\n", ESP.getCpuFreqMHz());
 
     // PSRAM Size
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "PSRAM Size: %u bytes\n",
-                       ESP.getPsramSize());
+    appendf(info, "PSRAM Size: %u bytes\n", ESP.getPsramSize());
 
     // PSRAM Free
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "PSRAM Free: %u bytes\n",
-                       ESP.getFreePsram());
+    appendf(info, "PSRAM Free: %u bytes\n", ESP.getFreePsram());
 
     // SDK Version
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "SDK Version: %s\n",
-                       ESP.getSdkVersion());
+    appendf(info, "SDK Version: %s\n", ESP.getSdkVersion());
 
     // Write closing tag
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "</pre>");
-
-    // Convert to String for compatibility
-    String info;
-    info.reserve(offset + 1);
-    info.concat(buffer, offset);
+    appendf(info, "</pre>");
 
     return wrapHtmlContent("System Information", info);
 }
 
 String WebServerService::getAppInfo() {
-    char buffer[2048];
-    size_t offset = 0;
+    String info;
+    info.reserve(4096);
 
     // Write metrics in pre tag
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "<pre>");
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "Uptime: %s\n",
-                       systemMetrics_.getFormattedUptime().c_str());
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "Free Heap: %u bytes\n",
-                       ESP.getFreeHeap());
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset,
-                       "Libre Hardware Monitor JSON Parse Time: %u ms\n",
-                       systemMetrics_.getPcMetricsJsonParseTime());
-    offset +=
-        snprintf(buffer + offset, sizeof(buffer) - offset, "Average Screen Draw Time: %u ms\n",
-                 static_cast<uint32_t>(systemMetrics_.getAverageScreenDrawTime()));
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "</pre>");
+    appendf(info, "<pre>");
+    appendf(info, "Uptime: %s\n", systemMetrics_.getFormattedUptime().c_str());
+    appendf(info, "Free Heap: %u bytes\n", ESP.getFreeHeap());
+    appendf(info, "Libre Hardware Monitor JSON Parse Time: %u ms\n",
+            systemMetrics_.getPcMetricsJsonParseTime());
+    for (bool binary : {false, true}) {
+        appendf(info, "PC Metrics Payload (%s): %u bytes, parse %u ms\n",
+                binary ? "MessagePack" : "JSON", systemMetrics_.getPcMetricsPayloadSize(binary),
+                systemMetrics_.getPcMetricsPayloadParseTime(binary));
+    }
+    appendf(info, "PC Metrics Peak Heap (streamed): %u bytes\n",
+            systemMetrics_.getPcMetricsPeakHeapStreamed());
+    appendf(info, "PC Metrics Peak Heap (buffered): %u bytes\n",
+            systemMetrics_.getPcMetricsPeakHeapBuffered());
+    appendf(info,
+            "PC Metrics JSON Arena: %u in PSRAM (%u bytes), high water %u bytes, "
+            "overflow %u bytes in %u polls\n",
+            systemMetrics_.getPcMetricsJsonArenaCount(),
+            systemMetrics_.getPcMetricsJsonArenaBytes(),
+            systemMetrics_.getPcMetricsJsonArenaHighWater(),
+            systemMetrics_.getPcMetricsJsonArenaOverflowHighWater(),
+            systemMetrics_.getPcMetricsJsonArenaSpillCount());
+    appendf(info, "LHM Requests (new connection): %u, avg %u ms\n",
+            systemMetrics_.getPcMetricsRequestCount(false),
+            static_cast<uint32_t>(systemMetrics_.getAveragePcMetricsRequestTime(false)));
+    appendf(info, "LHM Requests (reused connection): %u, avg %u ms\n",
+            systemMetrics_.getPcMetricsRequestCount(true),
+            static_cast<uint32_t>(systemMetrics_.getAveragePcMetricsRequestTime(true)));
+    appendf(info, "LHM Reconnects: %u\n", systemMetrics_.getPcMetricsReconnectCount());
+    appendf(info, "LHM Fetch Phases (ms)");
+    for (uint32_t bound : ApplicationMetrics::FETCH_BUCKET_BOUNDS_MS) {
+        char label[12];
+        snprintf(label, sizeof(label), "<=%u", bound);
+        appendf(info, " %6s", label);
+    }
+    appendf(info, " %6s\n", "more");
+    static const char* const kPhaseNames[FETCH_PHASE_COUNT] = {"connect", "ttfb", "transfer"};
+    for (size_t phase = 0; phase < FETCH_PHASE_COUNT; phase++) {
+        appendf(info, "  %-19s", kPhaseNames[phase]);
+        for (uint32_t count :
+             systemMetrics_.getPcMetricsFetchHistogram(static_cast<FetchPhase>(phase))) {
+            appendf(info, " %6u", count);
+        }
+        appendf(info, "\n");
+    }
+    appendf(info, "LHM Fetches Cancelled: %u\n", systemMetrics_.getPcMetricsFetchCancelledCount());
+    appendf(info, "LHM Refresh: period %u ms, phase %u ms, data age %u ms (%s)\n",
+            systemMetrics_.getPcMetricsHostPeriod(), systemMetrics_.getPcMetricsHostPhase(),
+            systemMetrics_.getPcMetricsDataAge(),
+            systemMetrics_.isPcMetricsHostLocked() ? "locked" : "estimating");
+    appendf(info, "PC Metrics Sample Latency: %u ms, dropped %u\n",
+            systemMetrics_.getPcMetricsSampleLatency(),
+            systemMetrics_.getPcMetricsDroppedSamples());
+    appendf(info, "PC Metrics Pushed: %u updates, avg %u bytes\n",
+            systemMetrics_.getPcMetricsPushCount(),
+            static_cast<uint32_t>(systemMetrics_.getAveragePcMetricsPushSize()));
+    for (uint8_t host = 0; host < pcMetricsHosts_.count(); host++) {
+        appendf(info, "LHM Host %u: %u polls, %u failed, avg fetch %u ms\n", host,
+                systemMetrics_.getPcMetricsHostPollCount(host),
+                systemMetrics_.getPcMetricsHostFailureCount(host),
+                static_cast<uint32_t>(systemMetrics_.getAveragePcMetricsHostFetchTime(host)));
+    }
+    appendf(info,
+            "Average Screen Draw Time: %u us CPU, %u us bus, %u us direct "
+            "(widgets without a sprite, CPU and bus together)\n",
+            static_cast<uint32_t>(systemMetrics_.getAverageScreenCpuTime()),
+            static_cast<uint32_t>(systemMetrics_.getAverageScreenBusTime()),
+            static_cast<uint32_t>(systemMetrics_.getAverageScreenDirectTime()));
+    appendf(info, "Screen Wakeups: %u notified, %u by deadline\n",
+            systemMetrics_.getScreenWakeupsNotified(), systemMetrics_.getScreenWakeupsTimed());
+    appendf(info,
+            "Screen Damage: %u frames, avg %u px flushed (%u px reported), last %u px, max %u px\n",
+            systemMetrics_.getScreenDamageFrameCount(),
+            static_cast<uint32_t>(systemMetrics_.getAverageScreenFlushedPixels()),
+            static_cast<uint32_t>(systemMetrics_.getAverageScreenReportedPixels()),
+            systemMetrics_.getLastScreenFlushedPixels(),
+            systemMetrics_.getMaxScreenFlushedPixels());
+    appendf(info, "Widget Sprites: %u in PSRAM (%u bytes), %u widgets drawing direct\n",
+            systemMetrics_.getScreenSpriteCount(), systemMetrics_.getScreenSpriteBytes(),
+            systemMetrics_.getScreenDirectWidgetCount());
+    appendf(info, "</pre>");
 
     // Write screen draw times as a table
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset,
-                       "<table class='draw-times'>"
-                       "<tr><th>Draw</th><th>Draw time (ms)</th></tr>");
+    appendf(info,
+            "<table class='draw-times'>"
+            "<tr><th>Draw</th><th>CPU (us)</th><th>Bus (us)</th>"
+            "<th>Direct (us)</th></tr>");
     const auto& drawTimes = systemMetrics_.getScreenDrawTimes();
     size_t count = systemMetrics_.getScreenDrawCount();
     for (size_t i = 0; i < count && i < drawTimes.size(); ++i) {
-        offset += snprintf(buffer + offset, sizeof(buffer) - offset,
-                           "<tr><td>%u</td><td>%u</td></tr>", i + 1, drawTimes[i]);
+        appendf(info, "<tr><td>%u</td><td>%u</td><td>%u</td><td>%u</td></tr>",
+                static_cast<uint32_t>(i + 1), drawTimes[i].cpuUs, drawTimes[i].busUs,
+                drawTimes[i].directUs);
     }
-    offset += snprintf(buffer + offset, sizeof(buffer) - offset, "</table>");
-
-    // Convert to String for compatibility
-    String info;
-    info.reserve(offset + 1);
-    info.concat(buffer, offset);
+    appendf(info, "</table>");
 
     return wrapHtmlContent("App Information", info);
 }
@@ -105,6 +189,24 @@ void WebServerService::handleAppInfo() {
     server_.send(200, "text/html", getAppInfo());
 }
 
+void WebServerService::handleMetricsPush() {
+    // WebServer keeps a non-form body in the "plain" argument
+    if (!server_.hasArg("plain")) {
+        server_.send(400, "text/plain", "Expected a text/plain body");
+        return;
+    }
+
+    uint8_t host = server_.hasArg("host") ? server_.arg("host").toInt() : 0;
+    const String& body = server_.arg("plain");
+
+    String error;
+    if (!pushReceiver_.apply(host, body.c_str(), body.length(), error)) {
+        server_.send(400, "text/plain", error);
+        return;
+    }
+    server_.send(204);
+}
+
 String WebServerService::wrapHtmlContent(const String& title, const String& content) {
     // Static HTML parts stored in flash
     static constexpr char kHtmlPrefix[] =
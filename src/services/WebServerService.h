@@ -2,11 +2,14 @@
 
 #include <WebServer.h>
 
-#include "ui/UiController.h"
+#include "services/pcMetrics/PcMetricsHosts.h"
+#include "services/pcMetrics/PcMetricsPushReceiver.h"
+#include "ui/UIController.h"
 
 class WebServerService {
  public:
-    WebServerService(UiController& uiController, ApplicationMetrics& systemMetrics);
+    WebServerService(UiController& uiController, ApplicationMetrics& systemMetrics,
+                     PcMetricsHosts& pcMetricsHosts, PcMetricsPushReceiver& pushReceiver);
     void begin();
     void processRequests();
 
@@ -14,11 +17,14 @@ class WebServerService {
     WebServer server_;
     UiController& uiController_;
     ApplicationMetrics& systemMetrics_;
+    PcMetricsHosts& pcMetricsHosts_;
+    PcMetricsPushReceiver& pushReceiver_;
 
     void handleNotFound();
     void handleHome();
     void handleSystemInfo();
     void handleAppInfo();
+    void handleMetricsPush();
 
     String getSystemInfo();
     String getAppInfo();
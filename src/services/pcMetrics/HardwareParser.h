@@ -4,8 +4,10 @@
 
 #include <cstdlib>
 
-#include "config/AppConfigInterface.h"
-#include "SensorFinder.h"
+#include "SensorIndex.h"
+#include "SensorMatcher.h"
+#include "SensorRegistry.h"
+#include "SensorValue.h"
 #include "services/pcMetrics/PcMetrics.h"
 #include "utils/LoggerInterface.h"
 
@@ -21,110 +23,103 @@ struct ParseResult {
 };
 
 /**
- * Base class for hardware component parsers
+ * Reads the SensorRegistry rows of one hardware node (CPU, GPU, ...) out of
+ * its sections. Which sections and sensors are read is entirely table driven;
+ * only the CPU thread loads, a series of unknown length, are handled here.
  */
 class HardwareParser {
  public:
     HardwareParser(LoggerInterface& logger) : logger_(logger) {}
-    virtual ~HardwareParser() = default;
 
-    virtual ParseResult parse(JsonArray children, PcMetrics& out) = 0;
+    /**
+     * Parse the Children of a hardware node of the given kind
+     * @return an error naming the first required sensor that was not found
+     */
+    ParseResult parse(HardwareKind kind, JsonArray children, PcMetrics& out);
+
+    /**
+     * Record the path of every sensor assigned during parse() into index.
+     * hardware is the position of this component in the hardware Children array.
+     */
+    void recordInto(SensorIndex* index, int hardware) {
+        index_ = index;
+        hardware_ = static_cast<int8_t>(hardware);
+    }
+
+    /**
+     * Convert a sensor value and store it in the PcMetrics value for id
+     */
+    static void storeValue(SensorId id, uint8_t slot, JsonVariant value, PcMetrics& out);
+
+    /**
+     * Store an already parsed value, unit as reported by SensorValue
+     */
+    static void storeValue(SensorId id, uint8_t slot, float value, SensorUnit unit,
+                           PcMetrics& out);
+
+ private:
+    static constexpr char THREAD_PREFIX[] = "CPU Core #";  // Not "CPU Core Max"
 
- protected:
     LoggerInterface& logger_;
+    SensorIndex* index_ = nullptr;
+    int8_t hardware_ = -1;
+
+    // Position of the node holding the sections (-1 if it is the hardware node itself)
+    // and of the section currently being parsed, used when recording paths
+    int8_t subHardware_ = -1;
+    int8_t section_ = -1;
 
     /**
-     * Parse a numeric value from JsonVariant with type conversion
+     * Store the sensor's value and, when recording, remember where it was found
+     */
+    void assign(JsonObject sensor, int sensorIndex, SensorId id, PcMetrics& out,
+                uint8_t slot = 0);
+
+    /**
+     * Assign every not yet found row of kind whose sensor type matches the section
+     * to its best ranked sensor, classifying each sensor with one SensorMatcher scan
+     * @param found bit per SensorId, updated with the rows assigned
+     */
+    void parseSection(HardwareKind kind, const char* sectionText, JsonArray sensors,
+                      PcMetrics& out, uint32_t& found);
+
+    /**
+     * Assign "CPU Core #N Thread #M" (or "CPU Core #N" without SMT) loads to
+     * thread slots in LHM's core/thread order
+     * @return number of threads found
+     */
+    uint8_t parseThreadLoads(JsonArray sensors, PcMetrics& out);
+
+    /**
+     * Parse a numeric value from JsonVariant with type conversion.
+     * outUnit, if given, receives the unit of string values (NONE for numbers).
      */
     template <typename T>
-    T parseValue(JsonVariant value, T defaultValue) {
+    static T parseValue(JsonVariant value, T defaultValue, SensorUnit* outUnit = nullptr) {
+        if (outUnit != nullptr) {
+            *outUnit = SensorUnit::NONE;
+        }
         if (value.isNull()) {
             return defaultValue;
         }
+
+        float result;
         if (value.is<float>() || value.is<int>()) {
-            float val = value.as<float>();
-            if constexpr (std::is_integral_v<T>) {
-                return static_cast<T>(val + 0.5f);  // Round to nearest
+            result = value.as<float>();
+        } else {
+            // Handle string values (e.g., "45.0 %", "40.5 °C") in place
+            SensorUnit unit;
+            if (!SensorValue::parse(value.as<const char*>(), result, unit)) {
+                return defaultValue;  // Conversion failed
+            }
+            if (outUnit != nullptr) {
+                *outUnit = unit;
             }
-            return static_cast<T>(val);
-        }
-        // Handle string values (e.g., "45.0 %", "40.5 °C")
-        String str = value.as<String>();
-        str.replace("%", "");
-        str.replace(" °C", "");
-        str.replace(" RPM", "");
-        str.replace(" W", "");
-        str.replace(" V", "");
-        str.replace(" MB", "");
-        str.replace(" GB", "");
-        str.trim();
-
-        char* endPtr;
-        float result = strtod(str.c_str(), &endPtr);
-        if (endPtr == str.c_str()) {
-            return defaultValue;  // Conversion failed
         }
+
         if constexpr (std::is_integral_v<T>) {
             return static_cast<T>(result + 0.5f);  // Round to nearest
         }
         return static_cast<T>(result);
     }
 };
-
-/**
- * Parser for CPU metrics (load, power, temperatures)
- */
-class CpuParser : public HardwareParser {
- public:
-    CpuParser(LoggerInterface& logger, AppConfigInterface& config)
-        : HardwareParser(logger), config_(config) {}
-
-    ParseResult parse(JsonArray children, PcMetrics& out) override;
-
- private:
-    AppConfigInterface& config_;
-    static constexpr size_t CPU_LOAD_OFFSET = 2;  // Skip CPU total and core max
-
-    ParseResult parseLoadMetrics(JsonArray loadSensors, PcMetrics& out);
-    ParseResult parsePowerMetrics(JsonArray powerSensors, PcMetrics& out);
-};
-
-/**
- * Parser for GPU metrics (load, memory, temperatures)
- */
-class GpuParser : public HardwareParser {
- public:
-    GpuParser(LoggerInterface& logger) : HardwareParser(logger) {}
-
-    ParseResult parse(JsonArray children, PcMetrics& out) override;
-
- private:
-    static constexpr float GPU_MEMORY_CAPACITY_MB = 16368.0f;
-
-    ParseResult parseLoadMetrics(JsonArray loadSensors, PcMetrics& out);
-    ParseResult parseMemoryMetrics(JsonArray dataSensors, PcMetrics& out);
-};
-
-/**
- * Parser for motherboard metrics (temperatures, fans)
- */
-class MotherboardParser : public HardwareParser {
- public:
-    MotherboardParser(LoggerInterface& logger) : HardwareParser(logger) {}
-
-    ParseResult parse(JsonArray children, PcMetrics& out) override;
-
- private:
-    ParseResult parseTemperatures(JsonArray tempSensors, PcMetrics& out);
-    ParseResult parseFans(JsonArray fanSensors, PcMetrics& out);
-};
-
-/**
- * Parser for memory/RAM metrics
- */
-class MemoryParser : public HardwareParser {
- public:
-    MemoryParser(LoggerInterface& logger) : HardwareParser(logger) {}
-
-    ParseResult parse(JsonArray children, PcMetrics& out) override;
-};
\ No newline at end of file
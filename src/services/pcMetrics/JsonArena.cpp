@@ -0,0 +1,129 @@
+#include "JsonArena.h"
+
+#include <esp_heap_caps.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr uint32_t kArenaCaps = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+constexpr uint32_t kOverflowCaps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+}  // namespace
+
+JsonArena::JsonArena(size_t capacity) {
+    if (capacity > 0) {
+        // Spare room to align the start, the heap only guarantees 4 bytes
+        raw_ = heap_caps_malloc(capacity + kAlign, kArenaCaps);
+    }
+    if (raw_ != nullptr) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(raw_);
+        base_ = reinterpret_cast<uint8_t*>((address + kAlign - 1) & ~uintptr_t(kAlign - 1));
+        capacity_ = capacity;
+    }
+}
+
+JsonArena::~JsonArena() {
+    heap_caps_free(raw_);
+}
+
+void* JsonArena::allocate(size_t size) {
+    size_t needed = kHeader + roundUp(size);
+    if (base_ == nullptr || needed > capacity_ - used_) {
+        return allocateOverflow(size);
+    }
+
+    lastOffset_ = used_;
+    used_ += needed;
+    void* ptr = base_ + lastOffset_ + kHeader;
+    sizeOf(ptr) = roundUp(size);
+    updateHighWater();
+    return ptr;
+}
+
+void JsonArena::deallocate(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (owns(ptr)) {
+        // Only the newest block can be given back before reset()
+        if (isLast(ptr)) {
+            used_ = lastOffset_;
+            lastOffset_ = kNoBlock;
+        }
+        return;
+    }
+    overflowUsed_ -= sizeOf(ptr);
+    heap_caps_free(header(ptr));
+}
+
+void* JsonArena::reallocate(void* ptr, size_t newSize) {
+    if (ptr == nullptr) {
+        return allocate(newSize);
+    }
+
+    size_t oldSize = sizeOf(ptr);
+    if (!owns(ptr)) {
+        auto* block = static_cast<uint8_t*>(heap_caps_realloc(header(ptr), kHeader + newSize,
+                                                              kOverflowCaps));
+        if (block == nullptr) {
+            return nullptr;
+        }
+        ptr = block + kHeader;
+        sizeOf(ptr) = newSize;
+        overflowUsed_ = overflowUsed_ - oldSize + newSize;
+        updateHighWater();
+        return ptr;
+    }
+
+    // The string being built and the pools growing are nearly always the newest block
+    if (isLast(ptr) && kHeader + roundUp(newSize) <= capacity_ - lastOffset_) {
+        used_ = lastOffset_ + kHeader + roundUp(newSize);
+        sizeOf(ptr) = roundUp(newSize);
+        updateHighWater();
+        return ptr;
+    }
+    if (!isLast(ptr) && newSize <= oldSize) {
+        return ptr;  // Shrunk in place, the tail stays taken until reset()
+    }
+
+    void* moved = allocate(newSize);
+    if (moved == nullptr) {
+        return nullptr;
+    }
+    memcpy(moved, ptr, std::min(oldSize, newSize));
+    deallocate(ptr);
+    return moved;
+}
+
+void JsonArena::reset() {
+    used_ = 0;
+    lastOffset_ = kNoBlock;
+    highWater_ = overflowUsed_;  // 0 unless a block of the last document leaked
+    overflowHighWater_ = overflowUsed_;
+}
+
+bool JsonArena::owns(void* ptr) const {
+    auto* bytes = static_cast<uint8_t*>(ptr);
+    return base_ != nullptr && bytes >= base_ && bytes < base_ + capacity_;
+}
+
+bool JsonArena::isLast(void* ptr) const {
+    return lastOffset_ != kNoBlock && header(ptr) == base_ + lastOffset_;
+}
+
+void* JsonArena::allocateOverflow(size_t size) {
+    auto* block = static_cast<uint8_t*>(heap_caps_malloc(kHeader + size, kOverflowCaps));
+    if (block == nullptr) {
+        return nullptr;
+    }
+    void* ptr = block + kHeader;
+    sizeOf(ptr) = size;
+    overflowUsed_ += size;
+    updateHighWater();
+    return ptr;
+}
+
+void JsonArena::updateHighWater() {
+    highWater_ = std::max(highWater_, used_ + overflowUsed_);
+    overflowHighWater_ = std::max(overflowHighWater_, overflowUsed_);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * ArduinoJson allocator over one block taken from PSRAM at construction.
+ * Allocations are bumped from the block and only given back by reset(), so
+ * a poll leaves no holes in the heap. What does not fit goes to internal
+ * RAM and is freed as usual. Without PSRAM (or with capacity 0) every
+ * allocation takes that path, which is the default allocator's behaviour.
+ *
+ * One document at a time: reset() invalidates every block handed out
+ * before, so the document using them must be gone.
+ */
+class JsonArena : public ArduinoJson::Allocator {
+ public:
+    explicit JsonArena(size_t capacity);
+    ~JsonArena();
+
+    JsonArena(const JsonArena&) = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+
+    void* allocate(size_t size) override;
+    void deallocate(void* ptr) override;
+    void* reallocate(void* ptr, size_t newSize) override;
+
+    /**
+     * Give back the whole block and start a new high-water count
+     */
+    void reset();
+
+    size_t capacity() const { return capacity_; }
+    bool inPsram() const { return base_ != nullptr; }
+
+    // Since the last reset: most bytes in use at once (block and overflow
+    // together), and most of them outside the block
+    size_t highWater() const { return highWater_; }
+    size_t overflowHighWater() const { return overflowHighWater_; }
+
+ private:
+    // Every block starts with its size, which keeps the data aligned
+    static constexpr size_t kAlign = alignof(std::max_align_t);
+    static constexpr size_t kHeader = kAlign;
+
+    static size_t roundUp(size_t size) { return (size + kAlign - 1) & ~(kAlign - 1); }
+    static size_t& sizeOf(void* ptr) { return *reinterpret_cast<size_t*>(header(ptr)); }
+    static uint8_t* header(void* ptr) { return static_cast<uint8_t*>(ptr) - kHeader; }
+
+    bool owns(void* ptr) const;
+    bool isLast(void* ptr) const;
+    void* allocateOverflow(size_t size);
+    void updateHighWater();
+
+    static constexpr size_t kNoBlock = SIZE_MAX;
+
+    void* raw_ = nullptr;  // As returned by the heap, base_ is aligned within it
+    uint8_t* base_ = nullptr;
+    size_t capacity_ = 0;
+    size_t used_ = 0;               // Bump offset into the block
+    size_t lastOffset_ = kNoBlock;  // Header of the newest block, grown or freed in place
+    size_t overflowUsed_ = 0;
+    size_t highWater_ = 0;
+    size_t overflowHighWater_ = 0;
+};
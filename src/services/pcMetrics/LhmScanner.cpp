@@ -0,0 +1,452 @@
+#include "LhmScanner.h"
+
+#include <cstring>
+
+namespace {
+
+// Non-zero if any byte of word equals c (may flag bytes above a real match)
+inline uint32_t hasByte(uint32_t word, uint8_t c) {
+    uint32_t x = word ^ (0x01010101u * c);
+    return (x - 0x01010101u) & ~x & 0x80808080u;
+}
+
+inline bool isStructural(char c) {
+    return c == '"' || c == '{' || c == '}' || c == '[' || c == ']';
+}
+
+inline bool isWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool isScalarEnd(char c) {
+    return c == ',' || c == '}' || c == ']' || isWhitespace(c);
+}
+
+inline int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+}  // namespace
+
+DeserializationError LhmScanner::scan(const char* data, size_t length, JsonDocument& out) {
+    stream_ = nullptr;
+    pos_ = data;
+    end_ = data + length;
+    return run(out);
+}
+
+DeserializationError LhmScanner::scan(Stream& input, JsonDocument& out) {
+    stream_ = &input;
+    pos_ = buffer_;
+    end_ = buffer_;
+    return run(out);
+}
+
+DeserializationError LhmScanner::run(JsonDocument& out) {
+    error_ = DeserializationError::Ok;
+    out.clear();
+
+    bool ok = parseNode(out.to<JsonObject>(), 0);
+    stream_ = nullptr;
+
+    if (!ok) {
+        return DeserializationError(error_);
+    }
+    if (out.overflowed()) {
+        return DeserializationError(DeserializationError::NoMemory);
+    }
+    return DeserializationError(DeserializationError::Ok);
+}
+
+// ============================================================================
+// Materialized nodes
+// ============================================================================
+
+bool LhmScanner::parseNode(JsonObject node, uint8_t depth) {
+    if (!expect('{')) {
+        return false;
+    }
+    if (!skipWhitespace()) {
+        return false;
+    }
+    if (*pos_ == '}') {
+        pos_++;
+        return true;
+    }
+
+    while (true) {
+        if (!expect('"') || !readString(key_, sizeof(key_)) || !expect(':') ||
+            !skipWhitespace()) {
+            return false;
+        }
+
+        bool ok;
+        if (strcmp(key_, "Text") == 0 && *pos_ == '"') {
+            pos_++;
+            ok = readString(text_, sizeof(text_));
+            if (ok) {
+                node["Text"] = static_cast<char*>(text_);
+            }
+        } else if (strcmp(key_, "Value") == 0 && depth >= kMinValueDepth) {
+            ok = parseValue(node);
+        } else if (strcmp(key_, "Children") == 0 && depth < kMaxNodeDepth && *pos_ == '[') {
+            ok = parseChildren(node["Children"].to<JsonArray>(), depth + 1);
+        } else {
+            ok = skipValue();
+        }
+
+        if (!ok || !skipWhitespace()) {
+            return false;
+        }
+
+        char c = *pos_++;
+        if (c == '}') {
+            return true;
+        }
+        if (c != ',') {
+            return fail(DeserializationError::InvalidInput);
+        }
+    }
+}
+
+bool LhmScanner::parseChildren(JsonArray children, uint8_t depth) {
+    if (!expect('[') || !skipWhitespace()) {
+        return false;
+    }
+    if (*pos_ == ']') {
+        pos_++;
+        return true;
+    }
+
+    while (true) {
+        if (!parseNode(children.add<JsonObject>(), depth) || !skipWhitespace()) {
+            return false;
+        }
+
+        char c = *pos_++;
+        if (c == ']') {
+            return true;
+        }
+        if (c != ',') {
+            return fail(DeserializationError::InvalidInput);
+        }
+    }
+}
+
+bool LhmScanner::parseValue(JsonObject node) {
+    // LHM sends values as text ("45.0 %"); accept plain numbers as well
+    if (*pos_ == '"') {
+        pos_++;
+        if (!readString(text_, sizeof(text_))) {
+            return false;
+        }
+        node["Value"] = static_cast<char*>(text_);
+        return true;
+    }
+
+    if (*pos_ == '-' || (*pos_ >= '0' && *pos_ <= '9')) {
+        size_t length = 0;
+        while (ensureData() && !isScalarEnd(*pos_)) {
+            if (length < kMaxTextLength) {
+                text_[length++] = *pos_;
+            }
+            pos_++;
+        }
+        text_[length] = '\0';
+        node["Value"] = strtof(text_, nullptr);
+        return true;
+    }
+
+    return skipValue();
+}
+
+// ============================================================================
+// Strings
+// ============================================================================
+
+bool LhmScanner::readString(char* out, size_t capacity) {
+    char* outPos = out;
+    const char* outEnd = out + capacity - 1;  // Longer strings are truncated
+
+    while (ensureData()) {
+        const char* stop = findStringEnd(pos_, end_);
+
+        size_t count = stop - pos_;
+        size_t room = outEnd - outPos;
+        memcpy(outPos, pos_, count < room ? count : room);
+        outPos += count < room ? count : room;
+        pos_ = stop;
+
+        if (pos_ == end_) {
+            continue;  // Refill and keep copying
+        }
+
+        if (*pos_ == '"') {
+            pos_++;
+            *outPos = '\0';
+            return true;
+        }
+
+        pos_++;  // Backslash
+        if (!readEscape(outPos, outEnd)) {
+            return false;
+        }
+    }
+
+    return fail(DeserializationError::IncompleteInput);
+}
+
+bool LhmScanner::readEscape(char*& out, const char* outEnd) {
+    if (!ensureData()) {
+        return fail(DeserializationError::IncompleteInput);
+    }
+
+    char c = *pos_++;
+    uint32_t codepoint = 0;
+    switch (c) {
+        case 'b':
+            codepoint = '\b';
+            break;
+        case 'f':
+            codepoint = '\f';
+            break;
+        case 'n':
+            codepoint = '\n';
+            break;
+        case 'r':
+            codepoint = '\r';
+            break;
+        case 't':
+            codepoint = '\t';
+            break;
+        case 'u':
+            for (int i = 0; i < 4; ++i) {
+                if (!ensureData()) {
+                    return fail(DeserializationError::IncompleteInput);
+                }
+                int digit = hexValue(*pos_++);
+                if (digit < 0) {
+                    return fail(DeserializationError::InvalidInput);
+                }
+                codepoint = (codepoint << 4) | digit;
+            }
+            break;
+        default:
+            codepoint = static_cast<uint8_t>(c);  // \" \\ \/
+            break;
+    }
+
+    // UTF-8 encode (e.g. "\u00B0C" -> "°C"), dropping what does not fit
+    char encoded[3];
+    size_t length;
+    if (codepoint < 0x80) {
+        encoded[0] = static_cast<char>(codepoint);
+        length = 1;
+    } else if (codepoint < 0x800) {
+        encoded[0] = static_cast<char>(0xC0 | (codepoint >> 6));
+        encoded[1] = static_cast<char>(0x80 | (codepoint & 0x3F));
+        length = 2;
+    } else {
+        encoded[0] = static_cast<char>(0xE0 | (codepoint >> 12));
+        encoded[1] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        encoded[2] = static_cast<char>(0x80 | (codepoint & 0x3F));
+        length = 3;
+    }
+    if (static_cast<size_t>(outEnd - out) >= length) {
+        memcpy(out, encoded, length);
+        out += length;
+    }
+    return true;
+}
+
+bool LhmScanner::skipString() {
+    while (ensureData()) {
+        pos_ = findStringEnd(pos_, end_);
+        if (pos_ == end_) {
+            continue;
+        }
+
+        if (*pos_++ == '"') {
+            return true;
+        }
+
+        // Escaped character; \uXXXX digits need no special treatment
+        if (!ensureData()) {
+            break;
+        }
+        pos_++;
+    }
+
+    return fail(DeserializationError::IncompleteInput);
+}
+
+// ============================================================================
+// Skipping
+// ============================================================================
+
+bool LhmScanner::skipContainer() {
+    int depth = 1;
+
+    while (ensureData()) {
+        pos_ = findStructural(pos_, end_);
+        if (pos_ == end_) {
+            continue;
+        }
+
+        switch (*pos_++) {
+            case '"':
+                if (!skipString()) {
+                    return false;
+                }
+                break;
+            case '{':
+            case '[':
+                depth++;
+                break;
+            default:  // '}' or ']'
+                if (--depth == 0) {
+                    return true;
+                }
+                break;
+        }
+    }
+
+    return fail(DeserializationError::IncompleteInput);
+}
+
+bool LhmScanner::skipScalar() {
+    while (ensureData()) {
+        if (isScalarEnd(*pos_)) {
+            return true;
+        }
+        pos_++;
+    }
+    // A scalar may legitimately end the input, the caller decides
+    return true;
+}
+
+bool LhmScanner::skipValue() {
+    if (!skipWhitespace()) {
+        return false;
+    }
+
+    switch (*pos_) {
+        case '"':
+            pos_++;
+            return skipString();
+        case '{':
+        case '[':
+            pos_++;
+            return skipContainer();
+        default:
+            return skipScalar();
+    }
+}
+
+// ============================================================================
+// Input handling
+// ============================================================================
+
+bool LhmScanner::skipWhitespace() {
+    while (ensureData()) {
+        if (!isWhitespace(*pos_)) {
+            return true;
+        }
+        pos_++;
+    }
+    return fail(DeserializationError::IncompleteInput);
+}
+
+bool LhmScanner::expect(char c) {
+    if (!skipWhitespace()) {
+        return false;
+    }
+    if (*pos_ != c) {
+        return fail(DeserializationError::InvalidInput);
+    }
+    pos_++;
+    return true;
+}
+
+bool LhmScanner::ensureData() {
+    if (pos_ < end_) {
+        return true;
+    }
+    if (stream_ == nullptr) {
+        return false;
+    }
+
+    // Block (up to the stream timeout) for one byte, then take whatever else has arrived
+    size_t count = stream_->readBytes(buffer_, 1);
+    if (count == 0) {
+        return false;
+    }
+    int available = stream_->available();
+    if (available > 0) {
+        size_t room = kBufferSize - count;
+        count += stream_->readBytes(buffer_ + count,
+                                    static_cast<size_t>(available) < room ? available : room);
+    }
+
+    pos_ = buffer_;
+    end_ = buffer_ + count;
+    return true;
+}
+
+bool LhmScanner::fail(DeserializationError::Code code) {
+    if (error_ == DeserializationError::Ok) {
+        error_ = code;
+    }
+    return false;
+}
+
+const char* LhmScanner::findStructural(const char* p, const char* end) {
+    while (end - p >= 4) {
+        uint32_t word;
+        memcpy(&word, p, sizeof(word));
+        // Setting bit 5 folds '[' onto '{' and ']' onto '}'
+        uint32_t folded = word | 0x20202020u;
+        if (hasByte(word, '"') | hasByte(folded, '{') | hasByte(folded, '}')) {
+            for (int i = 0; i < 4; ++i) {
+                if (isStructural(p[i])) {
+                    return p + i;
+                }
+            }
+        }
+        p += 4;
+    }
+
+    while (p < end && !isStructural(*p)) {
+        p++;
+    }
+    return p;
+}
+
+const char* LhmScanner::findStringEnd(const char* p, const char* end) {
+    while (end - p >= 4) {
+        uint32_t word;
+        memcpy(&word, p, sizeof(word));
+        if (hasByte(word, '"') | hasByte(word, '\\')) {
+            for (int i = 0; i < 4; ++i) {
+                if (p[i] == '"' || p[i] == '\\') {
+                    return p + i;
+                }
+            }
+        }
+        p += 4;
+    }
+
+    while (p < end && *p != '"' && *p != '\\') {
+        p++;
+    }
+    return p;
+}
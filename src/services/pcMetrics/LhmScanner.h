@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+/**
+ * Purpose-built reader for the Libre Hardware Monitor data.json schema.
+ *
+ * Produces the same document shape as the filtered ArduinoJson deserialization
+ * (nested Children with Text, and Value on sensor levels), so its output goes
+ * through the same HardwareParser code. Every other key (id, Min, Max,
+ * ImageURL, SensorId, Type, ...) and every subtree below the deepest sensor
+ * level is skipped by quote and bracket counting, four bytes at a time,
+ * without being tokenized.
+ */
+class LhmScanner {
+ public:
+    DeserializationError scan(const char* data, size_t length, JsonDocument& out);
+    DeserializationError scan(Stream& input, JsonDocument& out);
+
+ private:
+    static constexpr size_t kBufferSize = 512;
+    static constexpr size_t kMaxKeyLength = 15;
+    static constexpr size_t kMaxTextLength = 95;
+    static constexpr uint8_t kMinValueDepth = 4;  // Sensors sit at depth 4 and 5
+    static constexpr uint8_t kMaxNodeDepth = 5;   // Children below this depth are skipped
+
+    // Input window; refilled from stream_ when reading from a Stream
+    const char* pos_ = nullptr;
+    const char* end_ = nullptr;
+    Stream* stream_ = nullptr;
+    char buffer_[kBufferSize];
+
+    DeserializationError::Code error_ = DeserializationError::Ok;
+
+    char key_[kMaxKeyLength + 1];
+    char text_[kMaxTextLength + 1];
+
+    DeserializationError run(JsonDocument& out);
+
+    bool parseNode(JsonObject node, uint8_t depth);
+    bool parseChildren(JsonArray children, uint8_t depth);
+    bool parseValue(JsonObject node);
+
+    bool readString(char* out, size_t capacity);
+    bool readEscape(char*& out, const char* outEnd);
+    bool skipString();
+    bool skipContainer();
+    bool skipScalar();
+    bool skipValue();
+
+    bool skipWhitespace();
+    bool expect(char c);
+    bool ensureData();
+    bool fail(DeserializationError::Code code);
+
+    static const char* findStructural(const char* p, const char* end);
+    static const char* findStringEnd(const char* p, const char* end);
+};
@@ -3,31 +3,77 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
 
+#include "services/pcMetrics/SensorRegistry.h"
+
+/**
+ * Bits of PcMetrics::changed_fields. Bit n (n < SENSOR_COUNT) stands for SensorId n,
+ * see PcMetrics::fieldBit(); the top bits cover the non-table parts of a sample.
+ */
+enum PcMetricsField : uint32_t {
+    FIELD_CPU_THREAD_LOAD = 1u << 30,  // Any thread, see changed_threads for which
+    FIELD_AVAILABILITY = 1u << 31,
+    FIELD_ALL = 0xFFFFFFFFu
+};
+
+static_assert(SENSOR_COUNT <= 30, "Sensor bits would overlap the PcMetricsField bits");
+
 class PcMetrics {
  private:
  public:
+    // Capacity of cpu_thread_load. The sample is copied through PcMetricsSnapshot's
+    // seqlock, so it stays a fixed-size value; cpu_thread_count says how much is used.
+    static constexpr uint8_t MAX_THREADS = 64;
+    static constexpr uint64_t ALL_THREADS = ~0ull;
+
     bool is_available = false;
     unsigned long last_update_timestamp = 0;
 
-    uint8_t cpu_temperature = 0;
-    uint8_t gpu_temperature = 0;
+    // Fields that differ from the previously published sample (PcMetricsField bits)
+    uint32_t changed_fields = FIELD_ALL;
+    // One bit per cpu_thread_load entry that differs from the previous sample
+    uint64_t changed_threads = ALL_THREADS;
+
+    // Scalar values indexed by SensorId, in the unit of their SensorRegistry row
+    // divided by its scale
+    uint16_t values[SENSOR_COUNT] = {};
+
+    uint8_t cpu_thread_count = 0;  // Threads discovered, loads past it are unused
+    uint8_t cpu_thread_load[MAX_THREADS] = {};
 
-    uint8_t cpu_load = 0;
-    uint8_t mem_load = 0;
-    uint8_t cpu_thread_load[20] = {};
+    static constexpr uint32_t fieldBit(SensorId id) { return 1u << static_cast<uint8_t>(id); }
 
-    uint16_t cpu_power = 0;
+    uint16_t get(SensorId id) const { return values[static_cast<uint8_t>(id)]; }
+    void set(SensorId id, uint16_t value) { values[static_cast<uint8_t>(id)] = value; }
+    bool hasChanged(SensorId id) const { return (changed_fields & fieldBit(id)) != 0; }
 
-    uint16_t cpu_fan = 0;
-    uint16_t gpu_fan = 0;
-    uint16_t front_fan = 0;
-    uint16_t back_fan = 0;
+    /**
+     * Compare against the previous sample and fill changed_fields / changed_threads
+     */
+    void markChanges(const PcMetrics& previous) {
+        changed_threads = 0;
+        for (uint8_t i = 0; i < MAX_THREADS; i++) {
+            if (cpu_thread_load[i] != previous.cpu_thread_load[i]) {
+                changed_threads |= 1ull << i;
+            }
+        }
+        if (cpu_thread_count != previous.cpu_thread_count) {
+            changed_threads = ALL_THREADS;
+        }
 
-    uint8_t gpu_3d = 0;
-    uint8_t gpu_compute = 0;
-    uint8_t gpu_decode = 0;
-    uint8_t gpu_mem = 0;
+        uint32_t changed = 0;
+        for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+            changed |= values[i] != previous.values[i] ? 1u << i : 0;
+        }
+        changed |= is_available != previous.is_available ? FIELD_AVAILABILITY : 0;
+        changed |= changed_threads != 0 ? FIELD_CPU_THREAD_LOAD : 0;
+        changed_fields = changed;
+    }
 
-    float eth_up = 0;
-    float eth_dn = 0;
+    /**
+     * Treat every field as changed, e.g. after samples were skipped
+     */
+    void markAllChanged() {
+        changed_fields = FIELD_ALL;
+        changed_threads = ALL_THREADS;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "PcMetricsHostPoller.h"
+
+PcMetricsHostPoller::PcMetricsHostPoller(uint8_t host, PcMetricsHosts& hosts,
+                                         ApplicationMetrics& systemMetrics,
+                                         LoggerInterface& logger, AppConfigInterface& config)
+    : host_(host),
+      hostCount_(hosts.count()),
+      snapshot_(hosts.getSnapshot(host)),
+      systemMetrics_(systemMetrics),
+      logger_(logger),
+      config_(config),
+      service_(httpClient_, hosts.getUrl(host), systemMetrics, logger, config),
+      scheduler_(config) {
+    httpClient_.setKeepAlive(config_.getHardwareMonitorKeepAlive());
+}
+
+void PcMetricsHostPoller::resume(unsigned long nowMs) {
+    scheduler_.reset();
+    nextPollMs_ = nowMs + host_ * config_.getHardwareMonitorRefreshMs() / hostCount_;
+}
+
+bool PcMetricsHostPoller::isDue(unsigned long nowMs) const {
+    return static_cast<long>(nowMs - nextPollMs_) >= 0;
+}
+
+void PcMetricsHostPoller::poll() {
+    unsigned long startMs = millis();
+    bool success = service_.fetchData(workingMetrics_);
+    unsigned long polledAtMs = millis();
+    snapshot_.publish(workingMetrics_);
+
+    systemMetrics_.addPcMetricsHostPoll(host_, polledAtMs - startMs, success);
+    if (success) {
+        nextPollMs_ = polledAtMs + scheduler_.onSuccess(workingMetrics_, polledAtMs);
+    } else {
+        logger_.debugf("PC metrics update failed for host %u", host_);
+        nextPollMs_ = polledAtMs + scheduler_.onFailure();
+    }
+}
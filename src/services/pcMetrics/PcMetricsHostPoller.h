@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "config/AppConfigInterface.h"
+#include "network/HttpClient.h"
+#include "services/pcMetrics/PcMetrics.h"
+#include "services/pcMetrics/PcMetricsHosts.h"
+#include "services/pcMetrics/PcMetricsService.h"
+#include "services/pcMetrics/PollScheduler.h"
+#include "utils/ApplicationMetrics.h"
+#include "utils/LoggerInterface.h"
+
+/**
+ * Polls one of the extra LHM hosts on its own connection, parser and
+ * schedule. Each poller runs on its own task, so a slow host never holds up
+ * the others. Host 0 keeps going through the TaskManager fetch path.
+ */
+class PcMetricsHostPoller {
+ public:
+    PcMetricsHostPoller(uint8_t host, PcMetricsHosts& hosts, ApplicationMetrics& systemMetrics,
+                        LoggerInterface& logger, AppConfigInterface& config);
+
+    /**
+     * Start polling after a pause. The first poll is staggered by host index
+     * so hosts do not all send their requests at the same moment.
+     */
+    void resume(unsigned long nowMs);
+
+    bool isDue(unsigned long nowMs) const;
+
+    /**
+     * Fetch, parse and publish one sample, then schedule the next poll
+     */
+    void poll();
+
+ private:
+    uint8_t host_;
+    uint8_t hostCount_;
+    PcMetricsSnapshot& snapshot_;
+    ApplicationMetrics& systemMetrics_;
+    LoggerInterface& logger_;
+    AppConfigInterface& config_;
+
+    HttpClient httpClient_;
+    PcMetricsService service_;
+    PollScheduler scheduler_;
+    PcMetrics workingMetrics_;
+    unsigned long nextPollMs_ = 0;
+};
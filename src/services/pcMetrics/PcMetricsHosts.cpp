@@ -0,0 +1,35 @@
+#include "PcMetricsHosts.h"
+
+#include "config/Environment.h"
+
+PcMetricsHosts::PcMetricsHosts(PcMetricsSnapshot& primary, AppConfigInterface& config) {
+    addHost(LIBRE_HM_API, &primary);
+
+#ifdef LIBRE_HM_EXTRA_HOSTS
+    static const char* const extraHosts[] = {LIBRE_HM_EXTRA_HOSTS};
+    for (const char* url : extraHosts) {
+        if (count() >= config.getPcMetricsMaxHosts()) {
+            break;
+        }
+        extraSnapshots_.push_back(std::make_unique<PcMetricsSnapshot>());
+        addHost(url, extraSnapshots_.back().get());
+    }
+#endif
+}
+
+void PcMetricsHosts::addHost(const char* url, PcMetricsSnapshot* snapshot) {
+    hosts_.push_back(Host{url, hostName(url), snapshot});
+}
+
+String PcMetricsHosts::hostName(const char* url) {
+    // "http://192.168.1.11:8085/data.json" -> "192.168.1.11"
+    String name(url);
+    int start = name.indexOf("://");
+    start = start < 0 ? 0 : start + 3;
+
+    int end = start;
+    while (end < static_cast<int>(name.length()) && name[end] != ':' && name[end] != '/') {
+        end++;
+    }
+    return name.substring(start, end);
+}
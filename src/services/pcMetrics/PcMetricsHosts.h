@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <memory>
+#include <vector>
+
+#include "config/AppConfigInterface.h"
+#include "services/pcMetrics/PcMetricsSnapshot.h"
+
+/**
+ * The Libre Hardware Monitor endpoints being watched, each with its own
+ * snapshot. Host 0 is LIBRE_HM_API and publishes into the primary snapshot;
+ * LIBRE_HM_EXTRA_HOSTS (optional, see Environment.h.example) adds more, up
+ * to the configured maximum.
+ */
+class PcMetricsHosts {
+ public:
+    PcMetricsHosts(PcMetricsSnapshot& primary, AppConfigInterface& config);
+
+    uint8_t count() const { return static_cast<uint8_t>(hosts_.size()); }
+
+    const char* getUrl(uint8_t host) const { return hosts_[host].url; }
+    const String& getName(uint8_t host) const { return hosts_[host].name; }
+    PcMetricsSnapshot& getSnapshot(uint8_t host) { return *hosts_[host].snapshot; }
+
+ private:
+    struct Host {
+        const char* url;
+        String name;  // Host part of the url, for display
+        PcMetricsSnapshot* snapshot;
+    };
+
+    std::vector<Host> hosts_;
+    std::vector<std::unique_ptr<PcMetricsSnapshot>> extraSnapshots_;
+
+    void addHost(const char* url, PcMetricsSnapshot* snapshot);
+    static String hostName(const char* url);
+
+    // Non-copyable
+    PcMetricsHosts(const PcMetricsHosts&) = delete;
+    PcMetricsHosts& operator=(const PcMetricsHosts&) = delete;
+};
@@ -0,0 +1,73 @@
+#include "PcMetricsPipeline.h"
+
+PcMetricsPipeline::~PcMetricsPipeline() {
+    if (freeQueue_ != nullptr) {
+        vQueueDelete(freeQueue_);
+    }
+    if (readyQueue_ != nullptr) {
+        vQueueDelete(readyQueue_);
+    }
+    if (resultQueue_ != nullptr) {
+        vQueueDelete(resultQueue_);
+    }
+}
+
+bool PcMetricsPipeline::begin() {
+    if (freeQueue_ != nullptr) {
+        return true;
+    }
+
+    freeQueue_ = xQueueCreate(BUFFER_COUNT, sizeof(Sample*));
+    readyQueue_ = xQueueCreate(1, sizeof(Sample*));
+    // One result per sample, so it cannot fill up
+    resultQueue_ = xQueueCreate(BUFFER_COUNT, sizeof(Result));
+    if (freeQueue_ == nullptr || readyQueue_ == nullptr || resultQueue_ == nullptr) {
+        return false;
+    }
+
+    for (Sample& sample : samples_) {
+        Sample* entry = &sample;
+        xQueueSend(freeQueue_, &entry, 0);
+    }
+    return true;
+}
+
+PcMetricsPipeline::Sample* PcMetricsPipeline::acquire(TickType_t wait) {
+    Sample* sample = nullptr;
+    if (xQueueReceive(freeQueue_, &sample, wait) != pdTRUE) {
+        return nullptr;
+    }
+    return sample;
+}
+
+void PcMetricsPipeline::submit(Sample* sample) {
+    // Only this stage fills the ready queue, so once emptied the send cannot fail
+    Sample* stale = nullptr;
+    if (xQueueReceive(readyQueue_, &stale, 0) == pdTRUE) {
+        release(stale);
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    xQueueSend(readyQueue_, &sample, 0);
+}
+
+bool PcMetricsPipeline::takeResult(Result& result) {
+    return xQueueReceive(resultQueue_, &result, 0) == pdTRUE;
+}
+
+PcMetricsPipeline::Sample* PcMetricsPipeline::receive(TickType_t wait) {
+    Sample* sample = nullptr;
+    if (xQueueReceive(readyQueue_, &sample, wait) != pdTRUE) {
+        return nullptr;
+    }
+    return sample;
+}
+
+void PcMetricsPipeline::release(Sample* sample) {
+    if (sample != nullptr) {
+        xQueueSend(freeQueue_, &sample, 0);
+    }
+}
+
+void PcMetricsPipeline::report(const Result& result) {
+    xQueueSend(resultQueue_, &result, 0);
+}
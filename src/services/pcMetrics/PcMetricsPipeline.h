@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Arduino.h>
+#include <StreamString.h>
+
+#include <atomic>
+
+/**
+ * Buffer pool and handoff queue between the network stage (downloads LHM
+ * responses) and the parse stage (turns them into PcMetrics).
+ *
+ * The ready queue holds a single sample. When the network stage submits a
+ * new one before the parser picked up the previous, the older sample goes
+ * back to the pool unparsed: only the newest response is worth parsing.
+ * Three buffers cover one being filled, one waiting and one being parsed.
+ *
+ * Parse outcomes go back to the network stage over a result queue, so the
+ * poll schedule has a single owner.
+ */
+class PcMetricsPipeline {
+ public:
+    struct Sample {
+        StreamString body;
+        bool fetched = false;            // false if the download failed
+        unsigned long fetchStartMs = 0;  // Request sent
+        unsigned long fetchedMs = 0;     // Body fully received
+        uint32_t fetchHeapPeak = 0;      // Heap the download took, bytes
+    };
+
+    struct Result {
+        bool success;
+        unsigned long polledAtMs;
+        uint32_t fetchTimeMs;
+    };
+
+    PcMetricsPipeline() = default;
+    ~PcMetricsPipeline();
+
+    bool begin();
+
+    // Network stage
+    Sample* acquire(TickType_t wait);
+    void submit(Sample* sample);
+    bool takeResult(Result& result);
+
+    // Parse stage
+    Sample* receive(TickType_t wait);
+    void release(Sample* sample);
+    void report(const Result& result);
+
+    uint32_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+    static constexpr uint8_t BUFFER_COUNT = 3;
+
+    Sample samples_[BUFFER_COUNT];
+    QueueHandle_t freeQueue_ = nullptr;
+    QueueHandle_t readyQueue_ = nullptr;
+    QueueHandle_t resultQueue_ = nullptr;
+    std::atomic<uint32_t> dropped_{0};
+
+    // Non-copyable
+    PcMetricsPipeline(const PcMetricsPipeline&) = delete;
+    PcMetricsPipeline& operator=(const PcMetricsPipeline&) = delete;
+};
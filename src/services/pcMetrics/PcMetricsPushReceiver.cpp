@@ -0,0 +1,108 @@
+#include "PcMetricsPushReceiver.h"
+
+#include <cstring>
+
+#include "HardwareParser.h"
+#include "SensorRegistry.h"
+#include "SensorValue.h"
+
+namespace {
+bool isPairSeparator(char c) {
+    return c == '\n' || c == '\r' || c == '&' || c == ';';
+}
+}  // namespace
+
+PcMetricsPushReceiver::PcMetricsPushReceiver(PcMetricsHosts& hosts,
+                                             ApplicationMetrics& systemMetrics,
+                                             LoggerInterface& logger, AppConfigInterface& config)
+    : hosts_(hosts),
+      systemMetrics_(systemMetrics),
+      logger_(logger),
+      config_(config),
+      hostStates_(hosts.count()) {}
+
+bool PcMetricsPushReceiver::apply(uint8_t host, const char* body, size_t length,
+                                  String& outError) {
+    if (host >= hostStates_.size()) {
+        outError = "Unknown host";
+        return false;
+    }
+
+    HostState& state = hostStates_[host];
+    PcMetrics& metrics = state.metrics;
+
+    // Thread loads come whole with every push, the count follows what this one carries
+    metrics.cpu_thread_count = 0;
+
+    // Copy each pair out so values can be parsed as NUL-terminated strings
+    char pair[48];
+    size_t pos = 0;
+    while (pos < length) {
+        size_t end = pos;
+        while (end < length && !isPairSeparator(body[end])) {
+            end++;
+        }
+
+        size_t pairLength = end - pos;
+        if (pairLength > 0) {
+            if (pairLength >= sizeof(pair)) {
+                outError = "Pair too long";
+                return false;
+            }
+            memcpy(pair, body + pos, pairLength);
+            pair[pairLength] = '\0';
+
+            char* equals = strchr(pair, '=');
+            if (equals == nullptr || !applyPair(pair, equals - pair, equals + 1, metrics)) {
+                outError = String("Bad pair: ") + pair;
+                return false;
+            }
+        }
+        pos = end + 1;
+    }
+
+    metrics.is_available = true;
+    SensorRegistry::derive(metrics);
+    metrics.last_update_timestamp = millis();
+    hosts_.getSnapshot(host).publish(metrics);
+
+    uint32_t now = millis();
+    state.lastPushMs.store(now != 0 ? now : 1, std::memory_order_release);
+    systemMetrics_.addPcMetricsPush(length);
+    return true;
+}
+
+bool PcMetricsPushReceiver::isPushActive(uint8_t host) const {
+    if (host >= hostStates_.size()) {
+        return false;
+    }
+    uint32_t lastPushMs = hostStates_[host].lastPushMs.load(std::memory_order_acquire);
+    return lastPushMs != 0 && millis() - lastPushMs < config_.getHardwareMonitorPushTimeoutMs();
+}
+
+bool PcMetricsPushReceiver::applyPair(const char* key, size_t keyLength, const char* value,
+                                      PcMetrics& out) {
+    float number;
+    SensorUnit unit;
+    if (!SensorValue::parse(value, number, unit)) {
+        return false;
+    }
+
+    // t<N>: load of CPU thread N, everything else is a SensorRegistry key
+    if (keyLength >= 2 && key[0] == 't' && isdigit(static_cast<unsigned char>(key[1]))) {
+        unsigned long slot = strtoul(key + 1, nullptr, 10);
+        if (slot >= PcMetrics::MAX_THREADS) {
+            return false;
+        }
+        HardwareParser::storeValue(SensorId::CPU_THREAD_LOAD, static_cast<uint8_t>(slot),
+                                   number, unit, out);
+        return true;
+    }
+
+    const SensorDescriptor* sensor = SensorRegistry::findByKey(key, keyLength);
+    if (sensor == nullptr) {
+        return false;
+    }
+    HardwareParser::storeValue(sensor->id, 0, number, unit, out);
+    return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <atomic>
+#include <vector>
+
+#include "config/AppConfigInterface.h"
+#include "services/pcMetrics/PcMetrics.h"
+#include "services/pcMetrics/PcMetricsHosts.h"
+#include "utils/ApplicationMetrics.h"
+#include "utils/LoggerInterface.h"
+
+/**
+ * Applies metric updates pushed by the PC (see tools/metrics_push.py) to a
+ * host's snapshot, instead of polling the full LHM sensor tree.
+ *
+ * The body is a list of id=value pairs separated by newlines, '&' or ';',
+ * e.g. "cpu=35.2&mem=47&t0=12&t1=80&gpu_mem=6.1 GB", where ids are SensorRegistry
+ * keys and t<N> is the load of CPU thread N. Values accept the same
+ * forms as LHM value strings. Ids not present keep their previous value, so
+ * the sender only needs to send what changed. Thread loads are the exception:
+ * each push carries all of them, and the thread count is set from that push.
+ *
+ * While pushes keep arriving, polling for that host is paused.
+ */
+class PcMetricsPushReceiver {
+ public:
+    PcMetricsPushReceiver(PcMetricsHosts& hosts, ApplicationMetrics& systemMetrics,
+                          LoggerInterface& logger, AppConfigInterface& config);
+
+    /**
+     * Apply one pushed update and publish the result
+     * @return false if the host is unknown or a pair could not be parsed
+     */
+    bool apply(uint8_t host, const char* body, size_t length, String& outError);
+
+    /**
+     * True while pushes for host arrive often enough to replace polling
+     */
+    bool isPushActive(uint8_t host) const;
+
+ private:
+    struct HostState {
+        PcMetrics metrics;
+        std::atomic<uint32_t> lastPushMs{0};  // 0 until the first push
+    };
+
+    PcMetricsHosts& hosts_;
+    ApplicationMetrics& systemMetrics_;
+    LoggerInterface& logger_;
+    AppConfigInterface& config_;
+    std::vector<HostState> hostStates_;
+
+    static bool applyPair(const char* key, size_t keyLength, const char* value,
+                          PcMetrics& out);
+};
@@ -1,15 +1,31 @@
 #include "PcMetricsService.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "HardwareParser.h"
 
-PcMetricsService::PcMetricsService(NetworkManager& networkManager,
+PcMetricsService::PcMetricsService(HttpClient& httpClient, const char* url,
                                    ApplicationMetrics& systemMetrics, LoggerInterface& logger,
                                    AppConfigInterface& config)
-    : networkManager_(networkManager),
+    : httpClient_(httpClient),
+      url_(url),
       systemMetrics_(systemMetrics),
       logger_(logger),
-      config_(config) {
+      config_(config),
+      jsonArena_(config.getHardwareMonitorJsonArenaBytes()) {
     initFilter();
+    httpClient_.setFetchBudget(config_.getHardwareMonitorFetchBudgetMs());
+
+    if (jsonArena_.inPsram()) {
+        systemMetrics_.addPcMetricsJsonArena(jsonArena_.capacity());
+    }
+
+    // A translating proxy in front of LHM may answer in MessagePack, LHM itself
+    // ignores the header and keeps sending JSON
+    if (config_.getHardwareMonitorAcceptMsgPack()) {
+        httpClient_.setAccept(ACCEPT_MSGPACK);
+    }
 }
 
 void PcMetricsService::initFilter() {
@@ -36,28 +52,171 @@ void PcMetricsService::initFilter() {
 }
 
 bool PcMetricsService::fetchData(PcMetrics& outData) {
-    String rawData;
-    if (networkManager_.getHttpClient().download(LIBRE_HM_API, rawData)) {
-        return parseData(rawData, outData);
+    // Every Nth poll runs the other mode, so both peaks stay measured
+    bool streamed = config_.getHardwareMonitorStreamParse();
+    uint32_t compareInterval = config_.getHardwareMonitorModeCompareInterval();
+    if (compareInterval > 0 && ++fetchCount_ % compareInterval == 0) {
+        streamed = !streamed;
+    }
+
+    heapWatch_.begin();
+
+    bool success = false;
+    if (streamed) {
+        success = httpClient_.downloadStream(
+            url_, [this, &outData](Stream& body) { return parseStream(body, outData); });
     } else {
+        String rawData;
+        if (httpClient_.download(url_, rawData)) {
+            success = parseData(rawData, outData);
+        }
+    }
+
+    uint32_t heapPeak = heapWatch_.end();
+    recordRequest(httpClient_);
+
+    if (httpClient_.getLastHttpCode() != HTTP_CODE_OK) {
         outData.is_available = false;
-        Serial.println("Failed to fetch data from API");
+        logger_.errorf("Failed to fetch data from API (HTTP %d)", httpClient_.getLastHttpCode());
+        return false;
+    }
+
+    systemMetrics_.setPcMetricsPeakHeap(streamed, heapPeak);
+    return success;
+}
+
+bool PcMetricsService::fetchRaw(StreamString& outBody, uint32_t& outHeapPeak) {
+    // Runs on another task than parseRaw, so it keeps its heap readings to itself
+    HeapWatch heapWatch;
+    heapWatch.begin();
+    bool success = httpClient_.downloadInto(url_, outBody);
+    outHeapPeak = heapWatch.end();
+    recordRequest(httpClient_);
+
+    if (!success) {
+        logger_.errorf("Failed to fetch data from API (HTTP %d)", httpClient_.getLastHttpCode());
+    }
+    return success;
+}
+
+bool PcMetricsService::parseRaw(const String& rawData, uint32_t fetchHeapPeak,
+                                PcMetrics& outData) {
+    heapWatch_.begin();
+    bool success = parseData(rawData, outData);
+
+    // The body was allocated before the watch began, so it is added back
+    uint32_t parsePeak = rawData.length() + heapWatch_.end();
+    systemMetrics_.setPcMetricsPeakHeap(false, std::max(fetchHeapPeak, parsePeak));
+    return success;
+}
+
+void PcMetricsService::recordRequest(const HttpClient& httpClient) {
+    const HttpClient::RequestInfo& request = httpClient.getLastRequest();
+    if (request.cancelled) {
+        systemMetrics_.addPcMetricsFetchCancelled();
+    }
+    if (httpClient.getLastHttpCode() <= 0) {
+        return;
+    }
+
+    systemMetrics_.addPcMetricsRequest(request.timeMs, request.reusedConnection,
+                                       request.reconnected);
+    if (!request.reusedConnection) {
+        systemMetrics_.addPcMetricsFetchPhase(FetchPhase::CONNECT, request.connectMs);
+    }
+    systemMetrics_.addPcMetricsFetchPhase(FetchPhase::TTFB, request.ttfbMs);
+    if (httpClient.getLastHttpCode() == HTTP_CODE_OK) {
+        systemMetrics_.addPcMetricsFetchPhase(FetchPhase::TRANSFER, request.transferMs);
     }
-    return false;
 }
 
 bool PcMetricsService::parseData(const String& rawData, PcMetrics& outData) {
     unsigned long startTime = millis();
+    timings_ = ParseTimings();
+    unsigned long stageStart = micros();
+
+    PayloadFormat format =
+        rawData.length() > 0 ? detectFormat(static_cast<uint8_t>(rawData[0])) : PayloadFormat::JSON;
+
+    // The document of the previous parse is gone, its arena space can be reused
+    jsonArena_.reset();
+    JsonDocument doc(&jsonArena_);
+    DeserializationError error;
+    if (format == PayloadFormat::MSGPACK) {
+        error = deserializeMsgPack(doc, rawData.c_str(), rawData.length(),
+                                   DeserializationOption::Filter(filter_),
+                                   DeserializationOption::NestingLimit(12));
+    } else if (config_.getHardwareMonitorUseLhmScanner()) {
+        error = lhmScanner_.scan(rawData.c_str(), rawData.length(), doc);
+    } else {
+        error = deserializeJson(doc, rawData, DeserializationOption::Filter(filter_),
+                                DeserializationOption::NestingLimit(12));
+    }
+    timings_.deserializeUs = micros() - stageStart;
+
+    return processDocument(doc, error, startTime, format, rawData.length(), outData);
+}
+
+bool PcMetricsService::parseStream(Stream& body, PcMetrics& outData) {
+    // Parse time includes the transfer, since reading and parsing are interleaved
+    unsigned long startTime = millis();
+    timings_ = ParseTimings();
+    unsigned long stageStart = micros();
+
+    PayloadFormat format = detectFormat(peekFirstByte(body));
+
+    // The document of the previous parse is gone, its arena space can be reused
+    jsonArena_.reset();
+    JsonDocument doc(&jsonArena_);
+    DeserializationError error;
+    if (format == PayloadFormat::MSGPACK) {
+        error = deserializeMsgPack(doc, body, DeserializationOption::Filter(filter_),
+                                   DeserializationOption::NestingLimit(12));
+    } else if (config_.getHardwareMonitorUseLhmScanner()) {
+        error = lhmScanner_.scan(body, doc);
+    } else {
+        error = deserializeJson(doc, body, DeserializationOption::Filter(filter_),
+                                DeserializationOption::NestingLimit(12));
+    }
+    timings_.deserializeUs = micros() - stageStart;
+
+    // Unknown (0) for chunked responses
+    int contentLength = httpClient_.getLastRequest().contentLength;
+    return processDocument(doc, error, startTime, format, contentLength > 0 ? contentLength : 0,
+                           outData);
+}
+
+PcMetricsService::PayloadFormat PcMetricsService::detectFormat(int firstByte) {
+    // A MessagePack document starts with a map (fixmap, map 16 or map 32), a JSON
+    // one with '{' or whitespace
+    if ((firstByte & 0xF0) == 0x80 || firstByte == 0xDE || firstByte == 0xDF) {
+        return PayloadFormat::MSGPACK;
+    }
+    return PayloadFormat::JSON;
+}
+
+int PcMetricsService::peekFirstByte(Stream& body) {
+    // The body may not have arrived yet when the headers have
+    unsigned long startTime = millis();
+    int firstByte = body.peek();
+    while (firstByte < 0 && millis() - startTime < body.getTimeout()) {
+        delay(1);
+        firstByte = body.peek();
+    }
+    return firstByte;
+}
+
+bool PcMetricsService::processDocument(JsonDocument& doc, DeserializationError error,
+                                       unsigned long startTime, PayloadFormat format,
+                                       size_t payloadSize, PcMetrics& outData) {
+    // The filtered document (and the raw body, when buffered) are both alive here
+    heapWatch_.sample();
+    systemMetrics_.addPcMetricsJsonArenaUse(jsonArena_.highWater(),
+                                            jsonArena_.overflowHighWater());
 
     // Reset output data
     outData = PcMetrics();
 
-    // Deserialize JSON with filter
-    JsonDocument doc;
-    DeserializationError error =
-        deserializeJson(doc, rawData, DeserializationOption::Filter(filter_),
-                        DeserializationOption::NestingLimit(12));
-
     if (error) {
         outData.is_available = false;
         logger_.errorf("JSON deserialization failed: %s", error.c_str());
@@ -80,23 +239,35 @@ bool PcMetricsService::parseData(const String& rawData, PcMetrics& outData) {
         return false;
     }
 
-    // Find hardware component indices
-    HardwareIndices indices = findHardwareIndices(hardwareChildren);
-
-    // Parse each component
-    bool allComponentsValid = true;
-    allComponentsValid &= parseMotherboard(hardwareChildren, indices.motherboard, outData);
-    allComponentsValid &= parseCpu(hardwareChildren, indices.cpu, outData);
-    allComponentsValid &= parseMemory(hardwareChildren, indices.memory, outData);
-    allComponentsValid &= parseGpu(hardwareChildren, indices.gpu, outData);
+    // Read through the cached sensor paths, fall back to a full search if the tree changed
+    bool allComponentsValid = false;
+    if (sensorIndex_.isValid()) {
+        unsigned long stageStart = micros();
+        allComponentsValid = sensorIndex_.read(hardwareChildren, outData);
+        timings_.indexReadUs = micros() - stageStart;
+        if (!allComponentsValid) {
+            logger_.info("Sensor layout changed, rediscovering sensors");
+            outData = PcMetrics();
+        }
+    }
+    if (!allComponentsValid) {
+        allComponentsValid = discoverSensors(hardwareChildren, outData);
+    }
 
     // Update metrics
+    unsigned long deriveStart = micros();
+    SensorRegistry::derive(outData);
+    timings_.deriveUs = micros() - deriveStart;
     outData.last_update_timestamp = millis();
     outData.is_available = allComponentsValid;
 
     if (allComponentsValid) {
         unsigned long parseTime = millis() - startTime;
         systemMetrics_.setPcMetricsJsonParseTime(parseTime);
+        if (payloadSize > 0) {
+            systemMetrics_.setPcMetricsPayload(format == PayloadFormat::MSGPACK, payloadSize,
+                                               parseTime);
+        }
     } else {
         logger_.warning("Some hardware components missing or failed to parse");
     }
@@ -104,91 +275,88 @@ bool PcMetricsService::parseData(const String& rawData, PcMetrics& outData) {
     return allComponentsValid;
 }
 
-PcMetricsService::HardwareIndices
-PcMetricsService::findHardwareIndices(JsonArray hardwareChildren) {
-    HardwareIndices indices{-1, -1, -1, -1};
-
-    for (size_t i = 0; i < hardwareChildren.size(); i++) {
-        String text = hardwareChildren[i]["Text"] | "";
-
-        if (text.indexOf("Z790") >= 0 || text.indexOf("Motherboard") >= 0) {
-            indices.motherboard = i;
-        } else if (text.indexOf("Intel Core") >= 0 || text.indexOf("AMD Ryzen") >= 0) {
-            indices.cpu = i;
-        } else if (text.indexOf("Generic Memory") >= 0 || text.indexOf("Memory") >= 0) {
-            indices.memory = i;
-        } else if (text.indexOf("AMD Radeon") >= 0 || text.indexOf("NVIDIA") >= 0) {
-            indices.gpu = i;
-        }
-    }
+bool PcMetricsService::discoverSensors(JsonArray hardwareChildren, PcMetrics& outData) {
+    sensorIndex_.beginDiscovery();
+    timings_.discovered = true;
 
-    return indices;
-}
+    // Find hardware component indices
+    unsigned long stageStart = micros();
+    HardwareIndices indices = findHardwareIndices(hardwareChildren);
+    timings_.hardwareFindUs = micros() - stageStart;
 
-bool PcMetricsService::parseMotherboard(JsonArray hardwareChildren, int index, PcMetrics& outData) {
-    if (index < 0) {
-        logger_.warning("Motherboard section not found");
-        return false;
+    // Parse each component
+    bool allComponentsValid = true;
+    for (size_t kind = 0; kind < HARDWARE_KIND_COUNT; kind++) {
+        stageStart = micros();
+        allComponentsValid &= parseHardware(hardwareChildren, static_cast<HardwareKind>(kind),
+                                            indices[kind], outData);
+        timings_.hardwareParseUs[kind] = micros() - stageStart;
     }
 
-    JsonArray mbChildren = hardwareChildren[index]["Children"];
-    MotherboardParser parser(logger_);
-    ParseResult result = parser.parse(mbChildren, outData);
-
-    if (!result.success) {
-        logger_.warning("Motherboard parse failed: " + result.errorMessage);
+    // Only a complete parse is worth caching
+    if (allComponentsValid) {
+        sensorIndex_.commit();
+        logger_.debugf("Sensor index built with %u paths", sensorIndex_.size());
+    } else {
+        sensorIndex_.clear();
     }
 
-    return result.success;
+    return allComponentsValid;
 }
 
-bool PcMetricsService::parseCpu(JsonArray hardwareChildren, int index, PcMetrics& outData) {
-    if (index < 0) {
-        logger_.warning("CPU section not found");
-        return false;
-    }
-
-    JsonArray cpuChildren = hardwareChildren[index]["Children"];
-    CpuParser parser(logger_, config_);
-    ParseResult result = parser.parse(cpuChildren, outData);
-
-    if (!result.success) {
-        logger_.warning("CPU parse failed: " + result.errorMessage);
-    }
+PcMetricsService::HardwareIndices
+PcMetricsService::findHardwareIndices(JsonArray hardwareChildren) {
+    HardwareIndices indices;
+    indices.fill(-1);
 
-    return result.success;
-}
+    const HardwareRule* rules = SensorRegistry::hardware();
+    const SensorMatcher& matcher = SensorMatcher::instance();
+    for (size_t i = 0; i < hardwareChildren.size(); i++) {
+        uint8_t matched = matcher.scan(hardwareChildren[i]["Text"] | "").hardware;
 
-bool PcMetricsService::parseMemory(JsonArray hardwareChildren, int index, PcMetrics& outData) {
-    if (index < 0) {
-        logger_.warning("Memory section not found");
-        return false;
+        for (size_t kind = 0; kind < HARDWARE_KIND_COUNT; kind++) {
+            if (indices[kind] < 0 && (matched & (1u << kind))) {
+                indices[kind] = i;
+                break;
+            }
+        }
     }
 
-    JsonArray ramChildren = hardwareChildren[index]["Children"];
-    MemoryParser parser(logger_);
-    ParseResult result = parser.parse(ramChildren, outData);
-
-    if (!result.success) {
-        logger_.warning("Memory parse failed: " + result.errorMessage);
+    // Board names vary, so fall back to the first unclaimed node with a chip level
+    for (size_t kind = 0; kind < HARDWARE_KIND_COUNT; kind++) {
+        if (indices[kind] >= 0 || !rules[kind].hasSubHardware) {
+            continue;
+        }
+        for (size_t i = 0; i < hardwareChildren.size(); i++) {
+            bool claimed =
+                std::find(indices.begin(), indices.end(), static_cast<int>(i)) != indices.end();
+            JsonArray chipSensors = hardwareChildren[i]["Children"][0]["Children"][0]["Children"];
+            if (!claimed && chipSensors.size() > 0) {
+                indices[kind] = i;
+                break;
+            }
+        }
     }
 
-    return result.success;
+    return indices;
 }
 
-bool PcMetricsService::parseGpu(JsonArray hardwareChildren, int index, PcMetrics& outData) {
+bool PcMetricsService::parseHardware(JsonArray hardwareChildren, HardwareKind kind, int index,
+                                     PcMetrics& outData) {
+    const char* name = SensorRegistry::hardware()[static_cast<size_t>(kind)].name;
     if (index < 0) {
-        logger_.warning("GPU section not found");
+        logger_.warningf("%s section not found", name);
         return false;
     }
 
-    JsonArray gpuChildren = hardwareChildren[index]["Children"];
-    GpuParser parser(logger_);
-    ParseResult result = parser.parse(gpuChildren, outData);
+    JsonArray children = hardwareChildren[index]["Children"];
+    HardwareParser parser(logger_);
+    parser.recordInto(&sensorIndex_, index);
+    ParseResult result = parser.parse(kind, children, outData);
 
     if (!result.success) {
-        logger_.warning("GPU parse failed: " + result.errorMessage);
+        logger_.warning(String(name) + " parse failed: " + result.errorMessage);
     }
 
     return result.success;
-}
\ No newline at end of file
+}
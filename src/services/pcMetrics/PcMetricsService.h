@@ -2,40 +2,85 @@
 
 #include <ArduinoJson.h>
 
+#include <array>
+
 #include "config/AppConfigInterface.h"
-#include "config/Environment.h"
-#include "network/NetworkManager.h"
+#include "network/HttpClient.h"
+#include "services/pcMetrics/JsonArena.h"
+#include "services/pcMetrics/LhmScanner.h"
 #include "services/pcMetrics/PcMetrics.h"
+#include "services/pcMetrics/SensorIndex.h"
+#include "services/pcMetrics/SensorMatcher.h"
+#include "services/pcMetrics/SensorRegistry.h"
 #include "utils/ApplicationMetrics.h"
+#include "utils/HeapWatch.h"
 #include "utils/LoggerInterface.h"
 
 class PcMetricsService {
  public:
-    PcMetricsService(NetworkManager& networkManager, ApplicationMetrics& systemMetrics,
+    /**
+     * Duration of each stage of the last parse, in microseconds. Stages that
+     * did not run (discovery while the sensor index is valid) stay 0.
+     */
+    struct ParseTimings {
+        uint32_t deserializeUs = 0;  // Includes the transfer when streaming
+        uint32_t indexReadUs = 0;    // Reading through the cached sensor paths
+        uint32_t hardwareFindUs = 0;
+        uint32_t hardwareParseUs[HARDWARE_KIND_COUNT] = {};
+        uint32_t deriveUs = 0;
+        bool discovered = false;  // Full discovery ran instead of an index read
+    };
+
+    PcMetricsService(HttpClient& httpClient, const char* url, ApplicationMetrics& systemMetrics,
                      LoggerInterface& logger, AppConfigInterface& config);
     bool fetchData(PcMetrics& outData);
 
+    /**
+     * The two halves of fetchData, for running download and parse on separate
+     * tasks. fetchRaw gives the heap the download took, parseRaw reports the
+     * larger of that and the body plus the parse as the buffered peak.
+     */
+    bool fetchRaw(StreamString& outBody, uint32_t& outHeapPeak);
+    bool parseRaw(const String& rawData, uint32_t fetchHeapPeak, PcMetrics& outData);
+
+    const ParseTimings& getLastParseTimings() const { return timings_; }
+    const JsonArena& getJsonArena() const { return jsonArena_; }
+
  private:
-    struct HardwareIndices {
-        int motherboard;
-        int cpu;
-        int memory;
-        int gpu;
-    };
+    // Wire format of a data.json body, told apart by its first byte
+    enum class PayloadFormat : uint8_t { JSON, MSGPACK };
+
+    // Position of each HardwareKind in the hardware Children array, -1 if missing
+    using HardwareIndices = std::array<int, HARDWARE_KIND_COUNT>;
+
+    static constexpr const char* ACCEPT_MSGPACK = "application/msgpack, application/json;q=0.5";
 
     void initFilter();
     bool parseData(const String& rawData, PcMetrics& outData);
+    bool parseStream(Stream& body, PcMetrics& outData);
+    bool processDocument(JsonDocument& doc, DeserializationError error, unsigned long startTime,
+                         PayloadFormat format, size_t payloadSize, PcMetrics& outData);
+    static PayloadFormat detectFormat(int firstByte);
+    static int peekFirstByte(Stream& body);
+    void recordRequest(const HttpClient& httpClient);
 
+    bool discoverSensors(JsonArray hardwareChildren, PcMetrics& outData);
     HardwareIndices findHardwareIndices(JsonArray hardwareChildren);
-    bool parseMotherboard(JsonArray hardwareChildren, int index, PcMetrics& outData);
-    bool parseCpu(JsonArray hardwareChildren, int index, PcMetrics& outData);
-    bool parseMemory(JsonArray hardwareChildren, int index, PcMetrics& outData);
-    bool parseGpu(JsonArray hardwareChildren, int index, PcMetrics& outData);
+    bool parseHardware(JsonArray hardwareChildren, HardwareKind kind, int index,
+                       PcMetrics& outData);
 
-    NetworkManager& networkManager_;
+    HttpClient& httpClient_;
+    const char* url_;
     ApplicationMetrics& systemMetrics_;
     LoggerInterface& logger_;
     AppConfigInterface& config_;
 
     JsonDocument filter_;
+    JsonArena jsonArena_;  // Backs the parsed document, reset at the start of every parse
+    LhmScanner lhmScanner_;
+    SensorIndex sensorIndex_;
+    ParseTimings timings_;
+
+    HeapWatch heapWatch_;  // Over the current fetch (or parse, when pipelined)
+    uint32_t fetchCount_ = 0;
 };
\ No newline at end of file
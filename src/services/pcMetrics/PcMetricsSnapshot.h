@@ -0,0 +1,102 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <atomic>
+
+#include "services/pcMetrics/PcMetrics.h"
+
+/**
+ * Lock-free handoff of PcMetrics from the background task to the screen task.
+ *
+ * The writer fills its own PcMetrics and publishes a copy into the slot that
+ * readers are not using, then bumps the generation. Each slot carries a
+ * sequence counter (odd while being written) so a reader that raced with two
+ * consecutive publishes notices and retries. Readers never block. Writers
+ * (a poll task, or the push endpoint) are serialized by a mutex. A reader
+ * task can ask to be notified of every publish instead of polling.
+ */
+class PcMetricsSnapshot {
+ public:
+    PcMetricsSnapshot() : writeLock_(xSemaphoreCreateMutex()) {}
+    ~PcMetricsSnapshot() { vSemaphoreDelete(writeLock_); }
+
+    PcMetricsSnapshot(const PcMetricsSnapshot&) = delete;
+    PcMetricsSnapshot& operator=(const PcMetricsSnapshot&) = delete;
+
+    /**
+     * Publish a complete sample (writer side)
+     *
+     * The published copy carries a change mask against the previous generation.
+     */
+    void publish(const PcMetrics& metrics) {
+        xSemaphoreTake(writeLock_, portMAX_DELAY);
+        uint32_t current = generation_.load(std::memory_order_relaxed);
+        uint32_t next = current + 1;
+        Slot& slot = slots_[next & 1];
+
+        slot.sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.data = metrics;
+        if (current == 0) {
+            slot.data.markAllChanged();
+        } else {
+            // Writers hold the lock, so the current slot is stable here
+            slot.data.markChanges(slots_[current & 1].data);
+        }
+        slot.sequence.fetch_add(1, std::memory_order_release);
+
+        generation_.store(next, std::memory_order_release);
+        xSemaphoreGive(writeLock_);
+
+        TaskHandle_t subscriber = subscriber_.load(std::memory_order_acquire);
+        if (subscriber != nullptr) {
+            xTaskNotifyGive(subscriber);
+        }
+    }
+
+    /**
+     * Copy the latest sample into out (reader side)
+     * @return generation of the copied sample
+     */
+    uint32_t read(PcMetrics& out) const {
+        while (true) {
+            uint32_t generation = generation_.load(std::memory_order_acquire);
+            const Slot& slot = slots_[generation & 1];
+
+            uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence & 1) {
+                continue;  // Writer lapped us and is refilling this slot
+            }
+
+            out = slot.data;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+                return generation;
+            }
+        }
+    }
+
+    /**
+     * Generation of the latest sample, 0 before the first publish
+     */
+    uint32_t getGeneration() const { return generation_.load(std::memory_order_acquire); }
+
+    /**
+     * Task given a notification after every publish, nullptr for none
+     */
+    void setSubscriber(TaskHandle_t task) { subscriber_.store(task, std::memory_order_release); }
+
+ private:
+    struct Slot {
+        std::atomic<uint32_t> sequence{0};
+        PcMetrics data;
+    };
+
+    Slot slots_[2];
+    std::atomic<uint32_t> generation_{0};
+    std::atomic<TaskHandle_t> subscriber_{nullptr};
+    SemaphoreHandle_t writeLock_;
+};
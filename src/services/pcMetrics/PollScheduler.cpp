@@ -0,0 +1,203 @@
+#include "PollScheduler.h"
+
+#include <algorithm>
+
+namespace {
+uint8_t step(uint8_t a, uint8_t b) {
+    return a > b ? a - b : b - a;
+}
+}  // namespace
+
+PollScheduler::PollScheduler(AppConfigInterface& config)
+    : config_(config), intervalMs_(config.getHardwareMonitorRefreshMs()) {}
+
+uint32_t PollScheduler::onSuccess(const PcMetrics& sample, unsigned long nowMs) {
+    if (hasPrevious_) {
+        PcMetrics diff = sample;
+        diff.markChanges(previous_);
+        trackHostUpdate((diff.changed_fields & ~FIELD_AVAILABILITY) != 0, nowMs);
+    }
+    lastPollMs_ = nowMs;
+
+    adaptInterval(sample);
+    return locked_ ? delayToNextUpdate(nowMs) : intervalMs_;
+}
+
+void PollScheduler::adaptInterval(const PcMetrics& sample) {
+    const uint32_t baseMs = config_.getHardwareMonitorRefreshMs();
+    const uint32_t minMs = config_.getHardwareMonitorMinRefreshMs();
+    const uint32_t staticMs = config_.getHardwareMonitorStaticRefreshMs();
+
+    if (failures_ > 0 || !hasPrevious_) {
+        // Recovering or starting fresh, nothing to compare against yet
+        intervalMs_ = baseMs;
+    } else {
+        uint8_t loadStep = largestLoadStep(sample);
+        if (loadStep >= config_.getHardwareMonitorFastChangeDelta()) {
+            intervalMs_ = max(intervalMs_ / 2, minMs);
+        } else if (loadStep == 0) {
+            intervalMs_ = min(intervalMs_ + intervalMs_ / 2, staticMs);
+        } else if (intervalMs_ < baseMs) {
+            intervalMs_ = min(intervalMs_ + intervalMs_ / 4, baseMs);
+        } else if (intervalMs_ > baseMs) {
+            intervalMs_ = max(intervalMs_ / 2, baseMs);
+        }
+    }
+
+    failures_ = 0;
+    previous_ = sample;
+    hasPrevious_ = true;
+}
+
+uint32_t PollScheduler::onFailure() {
+    const uint32_t baseMs = config_.getHardwareMonitorFailureRefreshMs();
+    const uint32_t maxMs = config_.getHardwareMonitorMaxFailureBackoffMs();
+
+    // Cap the shift so the doubling cannot overflow
+    uint8_t shift = min<uint8_t>(failures_, 15);
+    if (failures_ < UINT8_MAX) {
+        failures_++;
+    }
+
+    uint32_t backoffMs = min<uint32_t>(baseMs << shift, maxMs);
+    intervalMs_ = backoffMs + random(0, config_.getHardwareMonitorFailureJitterMs());
+    hasPrevious_ = false;
+    return intervalMs_;
+}
+
+void PollScheduler::reset() {
+    intervalMs_ = config_.getHardwareMonitorRefreshMs();
+    failures_ = 0;
+    hasPrevious_ = false;
+    missed_ = false;
+}
+
+uint32_t PollScheduler::getHostPhaseMs() const {
+    return periodMs_ > 0 ? updateMs_ % periodMs_ : 0;
+}
+
+void PollScheduler::trackHostUpdate(bool changed, unsigned long nowMs) {
+    const uint32_t stepMs = config_.getHardwareMonitorPhaseStepMs();
+    // The host updated somewhere in (lastPollMs_, nowMs] if the values changed
+    const unsigned long windowStart = lastPollMs_;
+
+    // Latest expected host update at or before now
+    unsigned long predicted = updateMs_;
+    if (periodMs_ > 0 && static_cast<long>(nowMs - updateMs_) >= 0) {
+        predicted = updateMs_ + (nowMs - updateMs_) / periodMs_ * periodMs_;
+    }
+    const bool expected = locked_ && static_cast<long>(predicted - windowStart) > 0 &&
+                          static_cast<long>(nowMs - predicted) >= 0;
+
+    if (!changed) {
+        // Polled before the host updated, aim the retry just past this poll. A second
+        // miss in a row more likely means the values are static, so keep the phase then.
+        if (expected && !missed_) {
+            updateMs_ = nowMs + stepMs - periodMs_;
+            missed_ = true;
+        }
+        return;
+    }
+
+    // Responses with new values are a whole number of host periods apart
+    if (lastChangeMs_ != 0) {
+        trackPeriod(nowMs - lastChangeMs_);
+    }
+    lastChangeMs_ = nowMs;
+
+    if (!locked_) {
+        // Only the upper bound is known before the period settles
+        updateMs_ = nowMs;
+    } else if (expected) {
+        // Update landed where predicted. Creep earlier so the next miss re-measures the
+        // phase; without that a slightly long period estimate would drift polls later.
+        if (static_cast<long>(predicted - stepMs - windowStart) > 0) {
+            updateMs_ = predicted - stepMs;
+        } else {
+            updateMs_ = windowStart + 1;
+        }
+    } else {
+        updateMs_ = windowStart + (nowMs - windowStart) / 2;
+    }
+
+    missed_ = false;
+    lastDataAgeMs_ = nowMs - updateMs_;
+    if (!locked_ && gapsAgree()) {
+        locked_ = true;
+        disagreements_ = 0;
+    }
+}
+
+void PollScheduler::trackPeriod(uint32_t gapMs) {
+    const uint32_t minMs = config_.getHardwareMonitorMinRefreshMs();
+    const uint32_t maxMs = config_.getHardwareMonitorStaticRefreshMs();
+
+    if (!locked_) {
+        // A gap may span several host periods but never less than one, so the shortest
+        // recent gap is the estimate
+        std::copy_backward(gapsMs_, gapsMs_ + LOCK_PERIOD_SAMPLES - 1,
+                           gapsMs_ + LOCK_PERIOD_SAMPLES);
+        gapsMs_[0] = gapMs;
+        if (gapCount_ < LOCK_PERIOD_SAMPLES) {
+            gapCount_++;
+        }
+        periodMs_ = constrain(*std::min_element(gapsMs_, gapsMs_ + gapCount_), minMs, maxMs);
+        return;
+    }
+
+    uint32_t periods = max<uint32_t>(1, (gapMs + periodMs_ / 2) / periodMs_);
+    uint32_t perPeriodMs = gapMs / periods;
+    if (agrees(perPeriodMs, periodMs_)) {
+        disagreements_ = 0;
+        periodMs_ = constrain((periodMs_ * 3 + perPeriodMs) / 4, minMs, maxMs);
+    } else if (++disagreements_ >= UNLOCK_DISAGREEMENTS) {
+        // The host timer changed, measure it again from scratch
+        locked_ = false;
+        missed_ = false;
+        gapCount_ = 0;
+        disagreements_ = 0;
+    }
+}
+
+bool PollScheduler::gapsAgree() const {
+    if (gapCount_ < LOCK_PERIOD_SAMPLES) {
+        return false;
+    }
+    const uint32_t* shortest = std::min_element(gapsMs_, gapsMs_ + gapCount_);
+    const uint32_t* longest = std::max_element(gapsMs_, gapsMs_ + gapCount_);
+    return agrees(*longest, *shortest);
+}
+
+bool PollScheduler::agrees(uint32_t ms, uint32_t referenceMs) {
+    uint32_t difference = ms > referenceMs ? ms - referenceMs : referenceMs - ms;
+    return difference <= referenceMs * PERIOD_TOLERANCE_PERCENT / 100;
+}
+
+uint32_t PollScheduler::delayToNextUpdate(unsigned long nowMs) const {
+    unsigned long next = updateMs_;
+    if (static_cast<long>(nowMs - updateMs_) >= 0) {
+        next = updateMs_ + ((nowMs - updateMs_) / periodMs_ + 1) * periodMs_;
+    }
+
+    // The adaptive interval picks how many host updates to skip, a miss retries at once
+    if (!missed_) {
+        uint32_t periods = max<uint32_t>(1, (intervalMs_ + periodMs_ / 2) / periodMs_);
+        next += (periods - 1) * periodMs_;
+    }
+
+    return next - nowMs + config_.getHardwareMonitorPhaseGuardMs();
+}
+
+uint8_t PollScheduler::largestLoadStep(const PcMetrics& sample) const {
+    uint8_t largest = 0;
+    for (size_t i = 0; i < SensorRegistry::sensorCount(); i++) {
+        const SensorDescriptor& sensor = SensorRegistry::sensors()[i];
+        if (sensor.unit == SensorUnit::PERCENT) {
+            largest = max(largest, step(sample.get(sensor.id), previous_.get(sensor.id)));
+        }
+    }
+    for (uint8_t i = 0; i < sample.cpu_thread_count; i++) {
+        largest = max(largest, step(sample.cpu_thread_load[i], previous_.cpu_thread_load[i]));
+    }
+    return largest;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "config/AppConfigInterface.h"
+#include "services/pcMetrics/PcMetrics.h"
+
+/**
+ * Picks the delay before the next hardware monitor poll.
+ *
+ * Successful polls start from the configured refresh interval. The interval
+ * stretches towards the static ceiling while loads do not move, and shrinks
+ * towards the floor when a load jumps by more than the fast-change delta.
+ * Failures back off exponentially from the failure interval, with jitter.
+ *
+ * LHM refreshes its sensors on its own timer, so the scheduler also estimates
+ * that period and phase from the polls where values changed. The period locks
+ * once several gaps between changes agree, to the shortest of them, and
+ * unlocks again when later gaps stop agreeing with it. Once locked, polls are
+ * placed just after the expected host update and the adaptive interval only
+ * decides how many host periods to skip.
+ */
+class PollScheduler {
+ public:
+    explicit PollScheduler(AppConfigInterface& config);
+
+    /**
+     * Record a successful poll that completed at nowMs
+     * @return delay until the next poll in ms
+     */
+    uint32_t onSuccess(const PcMetrics& sample, unsigned long nowMs);
+
+    /**
+     * Record a failed poll
+     * @return delay until the next poll in ms
+     */
+    uint32_t onFailure();
+
+    /**
+     * Forget adaptive history, e.g. after polling was paused. The host
+     * period and phase estimate are kept since the host timer kept running.
+     */
+    void reset();
+
+    uint32_t getIntervalMs() const { return intervalMs_; }
+
+    // Host refresh estimate
+    bool isPhaseLocked() const { return locked_; }
+    uint32_t getHostPeriodMs() const { return periodMs_; }
+    uint32_t getHostPhaseMs() const;    // Offset of host updates within the period (millis())
+    uint32_t getLastDataAgeMs() const { return lastDataAgeMs_; }  // Poll time - host update
+
+ private:
+    static constexpr uint8_t LOCK_PERIOD_SAMPLES = 3;       // Agreeing gaps needed to lock
+    static constexpr uint8_t UNLOCK_DISAGREEMENTS = 2;      // Disagreeing gaps in a row to unlock
+    static constexpr uint32_t PERIOD_TOLERANCE_PERCENT = 10;  // Gaps this close agree
+
+    AppConfigInterface& config_;
+
+    // Adaptive interval
+    uint32_t intervalMs_;
+    uint8_t failures_ = 0;
+    bool hasPrevious_ = false;
+    PcMetrics previous_;
+
+    // Host refresh tracking
+    unsigned long lastPollMs_ = 0;
+    unsigned long lastChangeMs_ = 0;  // Poll time of the last response with new values
+    unsigned long updateMs_ = 0;      // Estimated time of a recent host update
+    uint32_t periodMs_ = 0;           // Estimated host refresh period, 0 while unknown
+    uint32_t gapsMs_[LOCK_PERIOD_SAMPLES] = {};  // Latest gaps between changes, newest first
+    uint8_t gapCount_ = 0;
+    uint8_t disagreements_ = 0;
+    bool locked_ = false;
+    bool missed_ = false;  // Last poll at the expected update saw no change
+    uint32_t lastDataAgeMs_ = 0;
+
+    void adaptInterval(const PcMetrics& sample);
+    void trackHostUpdate(bool changed, unsigned long nowMs);
+    void trackPeriod(uint32_t gapMs);
+    bool gapsAgree() const;
+    static bool agrees(uint32_t ms, uint32_t referenceMs);
+    uint32_t delayToNextUpdate(unsigned long nowMs) const;
+    uint8_t largestLoadStep(const PcMetrics& sample) const;
+};
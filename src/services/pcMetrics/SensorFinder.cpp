@@ -1,58 +1,81 @@
 #include "SensorFinder.h"
 
-JsonObject SensorFinder::findByExactName(JsonArray sensors, const char* name) {
+JsonObject SensorFinder::findByExactName(JsonArray sensors, const char* name, int* outIndex) {
+    setIndex(outIndex, -1);
     if (sensors.isNull() || name == nullptr) {
         return JsonObject();
     }
 
+    int index = 0;
     for (JsonObject sensor : sensors) {
         const char* text = sensor["Text"];
         if (text && strcmp(text, name) == 0) {
+            setIndex(outIndex, index);
             return sensor;
         }
+        index++;
     }
     return JsonObject();
 }
 
 JsonObject SensorFinder::findByPartialMatch(JsonArray sensors,
-                                            const std::vector<const char*>& patterns) {
-    if (sensors.isNull() || patterns.empty()) {
+                                            const std::vector<const char*>& patterns,
+                                            int* outIndex) {
+    return findByPartialMatch(sensors, patterns.data(), patterns.size(), outIndex);
+}
+
+JsonObject SensorFinder::findByPartialMatch(JsonArray sensors, const char* const* patterns,
+                                            size_t patternCount, int* outIndex) {
+    setIndex(outIndex, -1);
+    if (sensors.isNull() || patternCount == 0) {
         return JsonObject();
     }
 
+    int index = 0;
     for (JsonObject sensor : sensors) {
         const char* text = sensor["Text"];
-        if (text && textMatches(text, patterns)) {
+        if (text && textMatches(text, patterns, patternCount)) {
+            setIndex(outIndex, index);
             return sensor;
         }
+        index++;
     }
     return JsonObject();
 }
 
-JsonObject SensorFinder::findSection(JsonArray children, const char* sectionName) {
+JsonObject SensorFinder::findSection(JsonArray children, const char* sectionName,
+                                     int* outIndex) {
+    setIndex(outIndex, -1);
     if (children.isNull() || sectionName == nullptr) {
         return JsonObject();
     }
 
+    int index = 0;
     for (JsonObject child : children) {
         const char* text = child["Text"];
         if (text && textContains(text, sectionName)) {
+            setIndex(outIndex, index);
             return child;
         }
+        index++;
     }
     return JsonObject();
 }
 
-JsonObject SensorFinder::findContaining(JsonArray sensors, const char* substring) {
+JsonObject SensorFinder::findContaining(JsonArray sensors, const char* substring, int* outIndex) {
+    setIndex(outIndex, -1);
     if (sensors.isNull() || substring == nullptr) {
         return JsonObject();
     }
 
+    int index = 0;
     for (JsonObject sensor : sensors) {
         const char* text = sensor["Text"];
         if (text && textContains(text, substring)) {
+            setIndex(outIndex, index);
             return sensor;
         }
+        index++;
     }
     return JsonObject();
 }
@@ -64,15 +87,23 @@ bool SensorFinder::textContains(const char* text, const char* substring) {
     return strstr(text, substring) != nullptr;
 }
 
-bool SensorFinder::textMatches(const char* text, const std::vector<const char*>& patterns) {
+bool SensorFinder::textMatches(const char* text, const char* const* patterns,
+                               size_t patternCount) {
     if (text == nullptr) {
         return false;
     }
 
-    for (const char* pattern : patterns) {
+    for (size_t i = 0; i < patternCount; i++) {
+        const char* pattern = patterns[i];
         if (pattern && textContains(text, pattern)) {
             return true;
         }
     }
     return false;
-}
\ No newline at end of file
+}
+
+void SensorFinder::setIndex(int* outIndex, int value) {
+    if (outIndex != nullptr) {
+        *outIndex = value;
+    }
+}
@@ -6,31 +6,43 @@
 /**
  * Utility class for finding sensors in Libre Hardware Monitor JSON structure.
  * Provides flexible matching for different hardware configurations.
+ * When outIndex is given, it receives the position of the match (or -1).
  */
 class SensorFinder {
  public:
     /**
      * Find a sensor by exact text match
      */
-    static JsonObject findByExactName(JsonArray sensors, const char* name);
+    static JsonObject findByExactName(JsonArray sensors, const char* name,
+                                      int* outIndex = nullptr);
 
     /**
      * Find a sensor by checking if its Text field contains any of the patterns
      */
     static JsonObject findByPartialMatch(JsonArray sensors,
-                                         const std::vector<const char*>& patterns);
+                                         const std::vector<const char*>& patterns,
+                                         int* outIndex = nullptr);
+
+    /**
+     * Same, with the patterns as a fixed array (nullptr entries are skipped)
+     */
+    static JsonObject findByPartialMatch(JsonArray sensors, const char* const* patterns,
+                                         size_t patternCount, int* outIndex = nullptr);
 
     /**
      * Find a section (e.g., "Temperatures", "Load") within hardware children
      */
-    static JsonObject findSection(JsonArray children, const char* sectionName);
+    static JsonObject findSection(JsonArray children, const char* sectionName,
+                                  int* outIndex = nullptr);
 
     /**
      * Find first sensor containing the substring in its Text field
      */
-    static JsonObject findContaining(JsonArray sensors, const char* substring);
+    static JsonObject findContaining(JsonArray sensors, const char* substring,
+                                     int* outIndex = nullptr);
 
  private:
     static bool textContains(const char* text, const char* substring);
-    static bool textMatches(const char* text, const std::vector<const char*>& patterns);
-};
\ No newline at end of file
+    static bool textMatches(const char* text, const char* const* patterns, size_t patternCount);
+    static void setIndex(int* outIndex, int value);
+};
@@ -0,0 +1,57 @@
+#include "SensorIndex.h"
+
+#include "HardwareParser.h"
+
+void SensorIndex::beginDiscovery() {
+    paths_.clear();
+    valid_ = false;
+}
+
+void SensorIndex::record(const SensorPath& path) {
+    paths_.push_back(path);
+}
+
+void SensorIndex::commit() {
+    valid_ = !paths_.empty();
+}
+
+void SensorIndex::clear() {
+    paths_.clear();
+    valid_ = false;
+}
+
+bool SensorIndex::read(JsonArray hardwareChildren, PcMetrics& out) const {
+    if (!valid_ || hardwareChildren.isNull()) {
+        return false;
+    }
+
+    // Paths are recorded in parse order, so consecutive entries usually share a section
+    int8_t lastHardware = -1;
+    int8_t lastSubHardware = -1;
+    int8_t lastSection = -1;
+    JsonArray sensors;
+
+    for (const SensorPath& path : paths_) {
+        if (sensors.isNull() || path.hardware != lastHardware ||
+            path.subHardware != lastSubHardware || path.section != lastSection) {
+            JsonArray sections = hardwareChildren[path.hardware]["Children"];
+            if (path.subHardware >= 0) {
+                sections = sections[path.subHardware]["Children"];
+            }
+            sensors = sections[path.section]["Children"];
+            lastHardware = path.hardware;
+            lastSubHardware = path.subHardware;
+            lastSection = path.section;
+        }
+
+        JsonObject sensor = sensors[path.sensor];
+        const char* text = sensor["Text"];
+        if (text == nullptr || strcmp(text, path.expectedText.c_str()) != 0) {
+            return false;
+        }
+
+        HardwareParser::storeValue(path.id, path.slot, sensor["Value"], out);
+    }
+
+    return true;
+}
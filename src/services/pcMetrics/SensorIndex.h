@@ -0,0 +1,47 @@
+#pragma once
+
+#include <ArduinoJson.h>
+
+#include <vector>
+
+#include "services/pcMetrics/PcMetrics.h"
+
+/**
+ * Resolved location of one sensor below the hardware Children array
+ */
+struct SensorPath {
+    int8_t hardware;     // Index in the hardware Children array
+    int8_t subHardware;  // Index of the sub-hardware node (e.g. SuperIO chip), -1 if none
+    int8_t section;      // Index of the section ("Load", "Fans", ...)
+    int16_t sensor;      // Index of the sensor within the section
+    SensorId id;
+    uint8_t slot;  // Thread number for SensorId::CPU_THREAD_LOAD
+    String expectedText;  // Sensor Text at discovery time, used for validation
+};
+
+/**
+ * Cache of sensor paths resolved by the hardware parsers on a full parse.
+ * Later polls read values through the cached paths directly, skipping the
+ * text searches. Reading fails as soon as a sensor Text no longer matches,
+ * which signals that the tree changed and a rediscovery is needed.
+ */
+class SensorIndex {
+ public:
+    void beginDiscovery();
+    void record(const SensorPath& path);
+    void commit();
+    void clear();
+
+    bool isValid() const { return valid_; }
+    size_t size() const { return paths_.size(); }
+
+    /**
+     * Read all indexed sensors into out.
+     * @return false if any path no longer resolves to the expected sensor
+     */
+    bool read(JsonArray hardwareChildren, PcMetrics& out) const;
+
+ private:
+    std::vector<SensorPath> paths_;
+    bool valid_ = false;
+};
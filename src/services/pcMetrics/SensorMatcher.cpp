@@ -0,0 +1,136 @@
+#include "SensorMatcher.h"
+
+#include <algorithm>
+#include <deque>
+
+#include "PcMetrics.h"
+
+const SensorMatcher& SensorMatcher::instance() {
+    static const SensorMatcher matcher;
+    return matcher;
+}
+
+SensorMatcher::SensorMatcher() {
+    // Build the trie with a list of edges per state, flattened below
+    std::vector<std::vector<Edge>> trie(1);
+    std::vector<Matches> outputs(1);
+
+    auto add = [&](const char* pattern, const Matches& output) {
+        if (pattern == nullptr || *pattern == '\0') {
+            return;
+        }
+        uint16_t state = ROOT;
+        for (const char* p = pattern; *p != '\0'; p++) {
+            uint8_t byte = static_cast<uint8_t>(*p);
+            const std::vector<Edge>& edges = trie[state];
+            auto edge = std::find_if(edges.begin(), edges.end(),
+                                     [byte](const Edge& e) { return e.byte == byte; });
+            if (edge != edges.end()) {
+                state = edge->target;
+                continue;
+            }
+            uint16_t target = static_cast<uint16_t>(trie.size());
+            trie[state].push_back({byte, target});
+            trie.emplace_back();
+            outputs.emplace_back();
+            state = target;
+        }
+        outputs[state].merge(output);
+    };
+
+    for (size_t i = 0; i < SensorRegistry::sensorCount(); i++) {
+        const SensorDescriptor& row = SensorRegistry::sensors()[i];
+        uint32_t bit = PcMetrics::fieldBit(row.id);
+        kindRows_[static_cast<size_t>(row.hardware)] |= bit;
+
+        for (size_t rank = 0; rank < SENSOR_MATCH_PATTERNS; rank++) {
+            Matches sensor;
+            sensor.sensorRows = bit;
+            sensor.patternRows[rank] = bit;
+            add(row.match[rank], sensor);
+        }
+        Matches section;
+        section.sectionRows = bit;
+        add(row.section, section);
+    }
+    for (size_t kind = 0; kind < SensorRegistry::hardwareCount(); kind++) {
+        Matches hardware;
+        hardware.hardware = static_cast<uint8_t>(1u << kind);
+        for (const char* pattern : SensorRegistry::hardware()[kind].match) {
+            add(pattern, hardware);
+        }
+    }
+
+    states_.resize(trie.size());
+    for (size_t state = 0; state < trie.size(); state++) {
+        std::vector<Edge>& edges = trie[state];
+        std::sort(edges.begin(), edges.end(),
+                  [](const Edge& a, const Edge& b) { return a.byte < b.byte; });
+        states_[state].firstEdge = static_cast<uint16_t>(edges_.size());
+        states_[state].edgeCount = static_cast<uint16_t>(edges.size());
+        states_[state].output = outputs[state];
+        edges_.insert(edges_.end(), edges.begin(), edges.end());
+    }
+    for (const Edge& edge : trie[ROOT]) {
+        rootNext_[edge.byte] = edge.target;
+    }
+
+    link();
+}
+
+void SensorMatcher::link() {
+    // Breadth first, so the failure state of every state is finished before it
+    std::deque<uint16_t> queue;
+    queue.push_back(ROOT);
+    while (!queue.empty()) {
+        uint16_t state = queue.front();
+        queue.pop_front();
+
+        const State& parent = states_[state];
+        for (uint16_t i = 0; i < parent.edgeCount; i++) {
+            const Edge& edge = edges_[parent.firstEdge + i];
+            State& child = states_[edge.target];
+            // Longest proper suffix of the child's path that is also in the trie
+            child.fail = state == ROOT ? ROOT : next(parent.fail, edge.byte);
+            child.output.merge(states_[child.fail].output);
+            queue.push_back(edge.target);
+        }
+    }
+}
+
+uint16_t SensorMatcher::next(uint16_t state, uint8_t byte) const {
+    while (state != ROOT) {
+        int edge = findEdge(state, byte);
+        if (edge >= 0) {
+            return edges_[edge].target;
+        }
+        state = states_[state].fail;
+    }
+    return rootNext_[byte];
+}
+
+int SensorMatcher::findEdge(uint16_t state, uint8_t byte) const {
+    const State& s = states_[state];
+    for (uint16_t i = s.firstEdge; i < s.firstEdge + s.edgeCount; i++) {
+        if (edges_[i].byte == byte) {
+            return i;
+        }
+        if (edges_[i].byte > byte) {
+            break;
+        }
+    }
+    return -1;
+}
+
+SensorMatcher::Matches SensorMatcher::scan(const char* text) const {
+    Matches matches;
+    if (text == nullptr) {
+        return matches;
+    }
+    uint16_t state = ROOT;
+    for (const char* p = text; *p != '\0'; p++) {
+        state = next(state, static_cast<uint8_t>(*p));
+        matches.merge(states_[state].output);
+    }
+    return matches;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "services/pcMetrics/SensorRegistry.h"
+
+/**
+ * Aho-Corasick automaton over every pattern of the sensor table: hardware
+ * names, section names and sensor Text patterns. One scan of a Text reports
+ * all of them it contains, so a section is classified in a single pass over
+ * its sensors instead of a strstr per row, pattern and sensor. Matching is
+ * case sensitive, as strstr.
+ */
+class SensorMatcher {
+ public:
+    /**
+     * What a Text contains. Row masks use PcMetrics::fieldBit() bits.
+     */
+    struct Matches {
+        uint32_t sensorRows = 0;   // Rows with a match pattern in the Text
+        uint32_t sectionRows = 0;  // Rows whose section name is in the Text
+        uint8_t hardware = 0;      // Bit per HardwareKind with a name pattern in the Text
+        // sensorRows by the position of the pattern in the row's match list
+        uint32_t patternRows[SENSOR_MATCH_PATTERNS] = {};
+
+        void merge(const Matches& other) {
+            sensorRows |= other.sensorRows;
+            for (size_t i = 0; i < SENSOR_MATCH_PATTERNS; i++) {
+                patternRows[i] |= other.patternRows[i];
+            }
+            sectionRows |= other.sectionRows;
+            hardware |= other.hardware;
+        }
+    };
+
+    /**
+     * The automaton for SensorRegistry, built on first use
+     */
+    static const SensorMatcher& instance();
+
+    Matches scan(const char* text) const;
+
+    /**
+     * Rows of sensors that belong to kind
+     */
+    uint32_t rowsOf(HardwareKind kind) const { return kindRows_[static_cast<size_t>(kind)]; }
+
+    size_t stateCount() const { return states_.size(); }
+
+ private:
+    static constexpr uint16_t ROOT = 0;
+
+    struct State {
+        uint16_t firstEdge = 0;  // Edges of a state are contiguous, sorted by byte
+        uint16_t edgeCount = 0;
+        uint16_t fail = ROOT;
+        Matches output;  // Own patterns and those of every suffix state
+    };
+
+    struct Edge {
+        uint8_t byte;
+        uint16_t target;
+    };
+
+    SensorMatcher();
+
+    void link();
+    uint16_t next(uint16_t state, uint8_t byte) const;
+    int findEdge(uint16_t state, uint8_t byte) const;
+
+    std::vector<State> states_;
+    std::vector<Edge> edges_;
+    uint16_t rootNext_[256] = {};  // Most bytes fall back to the root, so it has a full table
+    uint32_t kindRows_[HARDWARE_KIND_COUNT] = {};
+};
@@ -0,0 +1,126 @@
+#include "SensorRegistry.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "PcMetrics.h"
+
+namespace {
+// clang-format off
+constexpr HardwareRule kHardware[] = {
+    // The board name varies (e.g. "ASUS ROG STRIX Z790-E"), so a node with a chip
+    // level is taken as the motherboard when no name matches
+    {HardwareKind::MOTHERBOARD, "Motherboard", {"Motherboard", "Mainboard", nullptr}, true},
+    {HardwareKind::CPU,         "CPU",         {"Intel Core", "AMD Ryzen", "Intel Xeon"}, false},
+    {HardwareKind::MEMORY,      "Memory",      {"Generic Memory", "Memory", nullptr}, false},
+    {HardwareKind::GPU,         "GPU",         {"AMD Radeon", "NVIDIA", "Intel Arc"}, false},
+};
+
+constexpr SensorDescriptor kSensors[] = {
+    {SensorId::CPU_LOAD, "cpu", HardwareKind::CPU, "Load",
+     {"CPU Total", nullptr, nullptr}, SensorUnit::PERCENT, 1, true, 0},
+    {SensorId::CPU_POWER, "cpu_w", HardwareKind::CPU, "Power",
+     {"CPU Package", "CPU", nullptr}, SensorUnit::WATT, 1, true, 0},
+    {SensorId::CPU_TEMPERATURE, "cpu_c", HardwareKind::MOTHERBOARD, "Temperature",
+     {"CPU", nullptr, nullptr}, SensorUnit::CELSIUS, 1, true, 0},
+    {SensorId::CPU_FAN, "fan_cpu", HardwareKind::MOTHERBOARD, "Fan",
+     {"CPU Fan", nullptr, nullptr}, SensorUnit::RPM, 1, false, 0},
+    {SensorId::FRONT_FAN, "fan_f", HardwareKind::MOTHERBOARD, "Fan",
+     {"System Fan #1", "Front", nullptr}, SensorUnit::RPM, 1, false, 0},
+    {SensorId::BACK_FAN, "fan_b", HardwareKind::MOTHERBOARD, "Fan",
+     {"System Fan #5", "Back", nullptr}, SensorUnit::RPM, 1, false, 0},
+    {SensorId::GPU_3D, "gpu_3d", HardwareKind::GPU, "Load",
+     {"D3D 3D", "GPU Core", nullptr}, SensorUnit::PERCENT, 1, false, 0},
+    {SensorId::GPU_COMPUTE, "gpu_cmp", HardwareKind::GPU, "Load",
+     {"D3D Compute", "Compute", nullptr}, SensorUnit::PERCENT, 1, false, 0},
+    {SensorId::GPU_MEM_USED, "gpu_mem", HardwareKind::GPU, "Data",
+     {"GPU Memory Used", "Memory Used", nullptr}, SensorUnit::MEGABYTE, 16, true, 0},
+    {SensorId::GPU_MEM_TOTAL, "gpu_mem_total", HardwareKind::GPU, "Data",
+     {"GPU Memory Total", "Memory Total", nullptr}, SensorUnit::MEGABYTE, 16, false, 16368},
+    {SensorId::MEM_LOAD, "mem", HardwareKind::MEMORY, "Load",
+     {"Memory", nullptr, nullptr}, SensorUnit::PERCENT, 1, true, 0},
+};
+
+constexpr DerivedSensor kDerived[] = {
+    {SensorId::GPU_MEM, SensorId::GPU_MEM_USED, SensorId::GPU_MEM_TOTAL},
+};
+// clang-format on
+
+constexpr size_t kSensorCount = sizeof(kSensors) / sizeof(kSensors[0]);
+
+constexpr bool rowsInIdOrder() {
+    for (size_t i = 0; i < kSensorCount; i++) {
+        if (static_cast<size_t>(kSensors[i].id) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(rowsInIdOrder(), "kSensors rows must be in SensorId order");
+
+constexpr bool hardwareInKindOrder() {
+    for (size_t i = 0; i < sizeof(kHardware) / sizeof(kHardware[0]); i++) {
+        if (static_cast<size_t>(kHardware[i].kind) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(hardwareInKindOrder(), "kHardware rows must be in HardwareKind order");
+
+constexpr bool scalesSet() {
+    for (const SensorDescriptor& sensor : kSensors) {
+        if (sensor.scale == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(scalesSet(), "kSensors rows need a scale of at least 1");
+static_assert(kSensorCount + sizeof(kDerived) / sizeof(kDerived[0]) == SENSOR_COUNT,
+              "Every SensorId needs a table row or a derived entry");
+}  // namespace
+
+const SensorDescriptor* SensorRegistry::sensors() {
+    return kSensors;
+}
+
+size_t SensorRegistry::sensorCount() {
+    return kSensorCount;
+}
+
+const HardwareRule* SensorRegistry::hardware() {
+    return kHardware;
+}
+
+size_t SensorRegistry::hardwareCount() {
+    return sizeof(kHardware) / sizeof(kHardware[0]);
+}
+
+const SensorDescriptor* SensorRegistry::find(SensorId id) {
+    size_t index = static_cast<size_t>(id);
+    return index < kSensorCount ? &kSensors[index] : nullptr;
+}
+
+const SensorDescriptor* SensorRegistry::findByKey(const char* key, size_t keyLength) {
+    for (const SensorDescriptor& sensor : kSensors) {
+        if (strlen(sensor.key) == keyLength && strncmp(sensor.key, key, keyLength) == 0) {
+            return &sensor;
+        }
+    }
+    return nullptr;
+}
+
+void SensorRegistry::derive(PcMetrics& metrics) {
+    for (const DerivedSensor& derived : kDerived) {
+        const SensorDescriptor* part = find(derived.part);
+        const SensorDescriptor* whole = find(derived.whole);
+        uint64_t partReading = uint64_t(metrics.get(derived.part)) * part->scale;
+        uint64_t wholeReading = uint64_t(metrics.get(derived.whole)) * whole->scale;
+        if (wholeReading == 0) {
+            wholeReading = whole->fallback;
+        }
+        uint64_t percent = wholeReading > 0 ? partReading * 100 / wholeReading : 0;
+        metrics.set(derived.id, static_cast<uint16_t>(std::min<uint64_t>(percent, 65535)));
+    }
+}
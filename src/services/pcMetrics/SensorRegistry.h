@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "services/pcMetrics/SensorValue.h"
+
+class PcMetrics;
+
+/**
+ * Stable ids of the scalar PC metrics, the index of each value in PcMetrics.
+ * CPU thread loads are a variable-length series and live outside this range.
+ */
+enum class SensorId : uint8_t {
+    CPU_LOAD,
+    CPU_POWER,
+    CPU_TEMPERATURE,
+    CPU_FAN,
+    FRONT_FAN,
+    BACK_FAN,
+    GPU_3D,
+    GPU_COMPUTE,
+    GPU_MEM_USED,
+    GPU_MEM_TOTAL,
+    MEM_LOAD,
+    GPU_MEM,  // Derived: GPU_MEM_USED as a percentage of GPU_MEM_TOTAL
+    COUNT,
+    CPU_THREAD_LOAD = COUNT  // slot = thread number, stored in PcMetrics::cpu_thread_load
+};
+
+constexpr size_t SENSOR_COUNT = static_cast<size_t>(SensorId::COUNT);
+
+/**
+ * Hardware nodes below the LHM computer node that sensors are read from
+ */
+enum class HardwareKind : uint8_t { MOTHERBOARD, CPU, MEMORY, GPU, COUNT };
+
+constexpr size_t HARDWARE_KIND_COUNT = static_cast<size_t>(HardwareKind::COUNT);
+
+constexpr size_t SENSOR_MATCH_PATTERNS = 3;  // Text patterns per table row
+
+/**
+ * How a hardware node is recognised by its Text
+ */
+struct HardwareRule {
+    HardwareKind kind;
+    const char* name;
+    const char* match[3];  // Text contains one of these (unused entries nullptr)
+    bool hasSubHardware;   // Sections sit below a chip node (e.g. the SuperIO of a board)
+};
+
+/**
+ * One row of the sensor table: where a sensor is found and how its value is stored
+ */
+struct SensorDescriptor {
+    SensorId id;
+    const char* key;        // Short name, as used by the push endpoint
+    HardwareKind hardware;  // Node the sensor belongs to
+    const char* section;    // Sensor type, the LHM section Text contains it ("Load", "Fan")
+    // Sensor Text contains one of these. Earlier patterns rank higher, the first
+    // sensor wins among equally ranked ones
+    const char* match[SENSOR_MATCH_PATTERNS];
+    SensorUnit unit;        // Stored unit, values reported in another unit are converted
+    uint16_t scale;         // Stored value is the reading divided by this, so it fits 16 bits
+    bool required;          // Discovery of the hardware fails without it
+    uint32_t fallback;      // Reading (in unit) used by derived values when there is none
+};
+
+/**
+ * Value computed from two table sensors after every parse
+ */
+struct DerivedSensor {
+    SensorId id;
+    SensorId part;   // Percentage of part in whole
+    SensorId whole;
+};
+
+/**
+ * The sensor table. Adding a metric is a row in SensorRegistry.cpp and an id
+ * above; parsers, the sensor index, the push endpoint and widgets all work
+ * from the id.
+ */
+class SensorRegistry {
+ public:
+    /**
+     * All rows, ordered by id (row i describes SensorId i)
+     */
+    static const SensorDescriptor* sensors();
+    static size_t sensorCount();
+
+    /**
+     * Hardware rules, ordered by kind
+     */
+    static const HardwareRule* hardware();
+    static size_t hardwareCount();
+
+    /**
+     * @return the row for id, nullptr for derived ids and thread loads
+     */
+    static const SensorDescriptor* find(SensorId id);
+
+    /**
+     * Look a row up by its push key
+     * @return nullptr if no row has that key
+     */
+    static const SensorDescriptor* findByKey(const char* key, size_t keyLength);
+
+    /**
+     * Recompute derived values from the table sensors in metrics
+     */
+    static void derive(PcMetrics& metrics);
+};
@@ -0,0 +1,156 @@
+#include "SensorValue.h"
+
+#include <cstring>
+
+namespace {
+
+struct UnitSuffix {
+    const char* text;
+    uint8_t length;
+    SensorUnit unit;
+};
+
+// Longer suffixes first where one is a prefix of another ("MB/s" before "MB")
+constexpr UnitSuffix kUnitSuffixes[] = {
+    {"%", 1, SensorUnit::PERCENT},
+    {"\u00B0C", 3, SensorUnit::CELSIUS},
+    {"\xB0" "C", 2, SensorUnit::CELSIUS},  // Latin-1 degree sign
+    {"RPM", 3, SensorUnit::RPM},
+    {"KB/s", 4, SensorUnit::KILOBYTE_PER_SEC},
+    {"MB/s", 4, SensorUnit::MEGABYTE_PER_SEC},
+    {"MB", 2, SensorUnit::MEGABYTE},
+    {"GB", 2, SensorUnit::GIGABYTE},
+    {"W", 1, SensorUnit::WATT},
+    {"V", 1, SensorUnit::VOLT},
+};
+
+constexpr float kPow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f};
+constexpr int8_t kMaxExponent = 9;
+constexpr uint32_t kMantissaLimit = 100000000;  // Further digits no longer fit a float
+constexpr uint32_t kExactMantissa = 1u << 24;   // Largest run of integers a float holds exactly
+
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline const char* skipSpaces(const char* p) {
+    while (*p == ' ' || *p == '\t') {
+        p++;
+    }
+    return p;
+}
+
+}  // namespace
+
+bool SensorValue::parse(const char* text, float& outValue, SensorUnit& outUnit) {
+    if (text == nullptr) {
+        return false;
+    }
+
+    const char* p = skipSpaces(text);
+
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        p++;
+    }
+
+    uint32_t mantissa = 0;
+    int8_t exponent = 0;
+    bool hasDigits = false;
+
+    for (; isDigit(*p); p++) {
+        hasDigits = true;
+        if (mantissa < kMantissaLimit) {
+            mantissa = mantissa * 10 + (*p - '0');
+        } else if (exponent < kMaxExponent) {
+            exponent++;
+        }
+    }
+
+    if ((*p == '.' || *p == ',') && isDigit(p[1])) {
+        for (p++; isDigit(*p); p++) {
+            hasDigits = true;
+            if (mantissa < kMantissaLimit && exponent > -kMaxExponent) {
+                mantissa = mantissa * 10 + (*p - '0');
+                exponent--;
+            }
+        }
+    }
+
+    if (!hasDigits) {
+        return false;
+    }
+
+    float value;
+    if (mantissa <= kExactMantissa) {
+        value = static_cast<float>(mantissa);
+        value = exponent >= 0 ? value * kPow10[exponent] : value / kPow10[-exponent];
+    } else {
+        // Rounding the mantissa to a float first would round twice, off by one step
+        double wide = static_cast<double>(mantissa);
+        wide = exponent >= 0 ? wide * kPow10[exponent] : wide / kPow10[-exponent];
+        value = static_cast<float>(wide);
+    }
+    outValue = negative ? -value : value;
+
+    p = skipSpaces(p);
+    if (*p == '\0') {
+        outUnit = SensorUnit::NONE;
+        return true;
+    }
+
+    outUnit = SensorUnit::UNKNOWN;
+    for (const UnitSuffix& suffix : kUnitSuffixes) {
+        if (strncmp(p, suffix.text, suffix.length) == 0 &&
+            *skipSpaces(p + suffix.length) == '\0') {
+            outUnit = suffix.unit;
+            break;
+        }
+    }
+    return true;
+}
+
+const char* SensorValue::unitSymbol(SensorUnit unit) {
+    switch (unit) {
+        case SensorUnit::PERCENT:
+            return "%";
+        case SensorUnit::CELSIUS:
+            return "\u00B0C";
+        case SensorUnit::RPM:
+            return "RPM";
+        case SensorUnit::WATT:
+            return "W";
+        case SensorUnit::VOLT:
+            return "V";
+        case SensorUnit::MEGABYTE:
+            return "MB";
+        case SensorUnit::GIGABYTE:
+            return "GB";
+        case SensorUnit::KILOBYTE_PER_SEC:
+            return "KB/s";
+        case SensorUnit::MEGABYTE_PER_SEC:
+            return "MB/s";
+        default:
+            return "";
+    }
+}
+
+float SensorValue::convert(float value, SensorUnit from, SensorUnit to) {
+    if (from == to || from == SensorUnit::NONE || from == SensorUnit::UNKNOWN) {
+        return value;  // Bare numbers are taken to be in the target unit already
+    }
+    if (from == SensorUnit::GIGABYTE && to == SensorUnit::MEGABYTE) {
+        return value * 1024.0f;
+    }
+    if (from == SensorUnit::MEGABYTE && to == SensorUnit::GIGABYTE) {
+        return value / 1024.0f;
+    }
+    if (from == SensorUnit::MEGABYTE_PER_SEC && to == SensorUnit::KILOBYTE_PER_SEC) {
+        return value * 1024.0f;
+    }
+    if (from == SensorUnit::KILOBYTE_PER_SEC && to == SensorUnit::MEGABYTE_PER_SEC) {
+        return value / 1024.0f;
+    }
+    return value;  // Unrelated units, nothing sensible to convert
+}
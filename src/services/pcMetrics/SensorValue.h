@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Unit suffix of a Libre Hardware Monitor value string
+ */
+enum class SensorUnit : uint8_t {
+    NONE,     // Bare number
+    UNKNOWN,  // Suffix present but not recognised
+    PERCENT,
+    CELSIUS,
+    RPM,
+    WATT,
+    VOLT,
+    MEGABYTE,
+    GIGABYTE,
+    KILOBYTE_PER_SEC,
+    MEGABYTE_PER_SEC
+};
+
+/**
+ * Allocation-free parser for LHM value strings such as "45.0 %", "40.5 °C",
+ * "1200 RPM" or "12,3 MB/s". Reads the number in place (accepting '.' or ','
+ * as the decimal separator) and reports the unit instead of stripping it.
+ */
+class SensorValue {
+ public:
+    /**
+     * @return false if text does not start with a number
+     */
+    static bool parse(const char* text, float& outValue, SensorUnit& outUnit);
+
+    static const char* unitSymbol(SensorUnit unit);
+
+    /**
+     * Convert between units of the same kind (GB to MB, MB/s to KB/s). Bare
+     * numbers and unrelated units are returned unchanged.
+     */
+    static float convert(float value, SensorUnit from, SensorUnit to);
+};
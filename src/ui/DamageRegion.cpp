@@ -0,0 +1,94 @@
+#include "DamageRegion.h"
+
+#include <algorithm>
+
+void DamageRegion::add(const Rect& rect) {
+    Rect merged = intersect(rect, {0, 0, width_, height_});
+    if (area(merged) == 0) {
+        return;
+    }
+    reportedPixels_ += area(merged);
+
+    // A merge can make the result reach rectangles it missed before, so start over after one
+    for (size_t i = 0; i < count_;) {
+        Rect united = unite(rects_[i], merged);
+        if (intersects(rects_[i], merged) || area(united) <= area(rects_[i]) + area(merged)) {
+            merged = united;
+            removeAt(i);
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+
+    if (count_ == MAX_RECTS) {
+        size_t best = 0;
+        uint32_t bestGrowth = UINT32_MAX;
+        for (size_t i = 0; i < count_; i++) {
+            uint32_t growth = area(unite(rects_[i], merged)) - area(rects_[i]);
+            if (growth < bestGrowth) {
+                best = i;
+                bestGrowth = growth;
+            }
+        }
+        merged = unite(rects_[best], merged);
+        removeAt(best);
+        add(merged);  // Merging again covers whatever the bigger rectangle now overlaps
+        reportedPixels_ -= area(merged);
+        return;
+    }
+    rects_[count_++] = merged;
+}
+
+void DamageRegion::clear() {
+    count_ = 0;
+    reportedPixels_ = 0;
+}
+
+DamageRegion::Rect DamageRegion::boundsWithin(const Rect& area) const {
+    Rect bounds = {0, 0, 0, 0};
+    for (const Rect& rect : *this) {
+        Rect part = intersect(rect, area);
+        if (DamageRegion::area(part) == 0) {
+            continue;
+        }
+        bounds = DamageRegion::area(bounds) == 0 ? part : unite(bounds, part);
+    }
+    return bounds;
+}
+
+uint32_t DamageRegion::pixelCount() const {
+    uint32_t pixels = 0;
+    for (const Rect& rect : *this) {
+        pixels += area(rect);
+    }
+    return pixels;
+}
+
+bool DamageRegion::intersects(const Rect& a, const Rect& b) {
+    return area(intersect(a, b)) > 0;
+}
+
+DamageRegion::Rect DamageRegion::unite(const Rect& a, const Rect& b) {
+    uint16_t left = std::min(a.x, b.x);
+    uint16_t top = std::min(a.y, b.y);
+    uint16_t right = std::max(a.x + a.width, b.x + b.width);
+    uint16_t bottom = std::max(a.y + a.height, b.y + b.height);
+    return {left, top, static_cast<uint16_t>(right - left), static_cast<uint16_t>(bottom - top)};
+}
+
+DamageRegion::Rect DamageRegion::intersect(const Rect& a, const Rect& b) {
+    int32_t left = std::max(a.x, b.x);
+    int32_t top = std::max(a.y, b.y);
+    int32_t right = std::min(a.x + a.width, b.x + b.width);
+    int32_t bottom = std::min(a.y + a.height, b.y + b.height);
+    if (right <= left || bottom <= top) {
+        return {0, 0, 0, 0};
+    }
+    return {static_cast<uint16_t>(left), static_cast<uint16_t>(top),
+            static_cast<uint16_t>(right - left), static_cast<uint16_t>(bottom - top)};
+}
+
+void DamageRegion::removeAt(size_t index) {
+    rects_[index] = rects_[--count_];
+}
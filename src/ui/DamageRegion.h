@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ui/widgets/WidgetInterface.h"
+
+/**
+ * Screen areas to redraw in one frame. Rectangles are clipped to the screen
+ * and merged as they are added, so a frame ends up with a few of them: two
+ * are merged when they overlap or when their bounding box is no bigger than
+ * both together (neighbouring bars, adjacent text lines). Past MAX_RECTS the
+ * new one is merged into the rectangle it grows least.
+ */
+class DamageRegion {
+ public:
+    using Rect = WidgetInterface::Dimensions;
+
+    static constexpr size_t MAX_RECTS = 16;
+
+    DamageRegion(uint16_t width, uint16_t height) : width_(width), height_(height) {}
+
+    void add(const Rect& rect);
+    void addAll() { add({0, 0, width_, height_}); }
+    void clear();
+
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+    const Rect* begin() const { return rects_; }
+    const Rect* end() const { return rects_ + count_; }
+
+    /**
+     * Bounding box of the damage inside area, empty (width 0) if none
+     */
+    Rect boundsWithin(const Rect& area) const;
+
+    // Pixels added since clear() (after clipping), and pixels in the merged rectangles
+    uint32_t reportedPixels() const { return reportedPixels_; }
+    uint32_t pixelCount() const;
+
+    static uint32_t area(const Rect& rect) { return uint32_t(rect.width) * rect.height; }
+    static bool intersects(const Rect& a, const Rect& b);
+    static Rect unite(const Rect& a, const Rect& b);
+    static Rect intersect(const Rect& a, const Rect& b);
+
+ private:
+    void removeAt(size_t index);
+
+    uint16_t width_;
+    uint16_t height_;
+    Rect rects_[MAX_RECTS] = {};
+    size_t count_ = 0;
+    uint32_t reportedPixels_ = 0;
+};
@@ -4,9 +4,9 @@
  *
  * The DisplayContext class serves as a lightweight container that bundles references to
  * essential display-related resources: the display driver (LGFX), color management
- * (Colors), and logging interface (LoggerInterface). It simplifies passing these
- * resources to widgets and screens, reducing parameter bloat and ensuring consistent
- * access.
+ * (Colors), cached number glyphs (GlyphAtlas), and logging interface (LoggerInterface).
+ * It simplifies passing these resources to widgets and screens, reducing parameter bloat
+ * and ensuring consistent access.
  *
  * @note This class is designed to be passed by reference to avoid unnecessary copying.
  *       It does not own the resources it references; the caller is responsible for their
@@ -16,13 +16,14 @@
 #pragma once
 
 #include "Colors.h"
+#include "GlyphAtlas.h"
 #include "config/LgfxConfig.h"
 #include "utils/LoggerInterface.h"
 
 class DisplayContext {
  public:
-    DisplayContext(LGFX& display, Colors& colors, LoggerInterface& logger)
-        : display_(display), colors_(colors), logger_(logger) {}
+    DisplayContext(LGFX& display, Colors& colors, GlyphAtlas& glyphs, LoggerInterface& logger)
+        : display_(display), colors_(colors), glyphs_(glyphs), logger_(logger) {}
 
     DisplayContext(const DisplayContext&) = delete;
     DisplayContext& operator=(const DisplayContext&) = delete;
@@ -39,6 +40,12 @@ class DisplayContext {
      */
     Colors& getColors() { return colors_; }
 
+    /**
+     * @brief Gets the pre-rasterized glyphs for drawing numbers.
+     * @return Reference to the GlyphAtlas object.
+     */
+    GlyphAtlas& getGlyphs() { return glyphs_; }
+
     /**
      * @brief Gets the logger interface.
      * @return Reference to the LoggerInterface.
@@ -48,5 +55,6 @@ class DisplayContext {
  private:
     LGFX& display_;
     Colors& colors_;
+    GlyphAtlas& glyphs_;
     LoggerInterface& logger_;
 };
\ No newline at end of file
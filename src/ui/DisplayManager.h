@@ -3,7 +3,6 @@
 #include <LovyanGFX.hpp>
 
 #include "../config/LgfxConfig.h"
-#include "Config.h"
 #include "utils/LoggerInterface.h"
 
 class DisplayManager {
@@ -0,0 +1,130 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+
+namespace {
+// Latin-1, so the degree sign is one byte here and two in the UTF-8 widget text
+constexpr char CHARSET[] = "0123456789%:.,-+ /\xB0" "CRPMWVBGKs";
+constexpr size_t CHARSET_SIZE = sizeof(CHARSET) - 1;
+
+// The font engine decodes UTF-8, so the character is handed to it that way
+void encodeUtf8(char character, char (&text)[3]) {
+    uint8_t code = static_cast<uint8_t>(character);
+    if (code < 0x80) {
+        text[0] = static_cast<char>(code);
+        text[1] = '\0';
+    } else {
+        text[0] = static_cast<char>(0xC0 | (code >> 6));
+        text[1] = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    text[2] = '\0';
+}
+}  // namespace
+
+GlyphAtlas::GlyphAtlas(LGFX& display, bool enabled) : display_(display), enabled_(enabled) {
+    index_.fill(-1);
+    for (size_t i = 0; i < CHARSET_SIZE; i++) {
+        index_[static_cast<uint8_t>(CHARSET[i])] = static_cast<int8_t>(i);
+    }
+}
+
+int32_t GlyphAtlas::textWidth(const char* text, uint8_t textSize) {
+    Face* atlas = face(textSize);
+    if (atlas == nullptr) {
+        return -1;
+    }
+    int32_t width = 0;
+    while (*text != '\0') {
+        int index = glyphIndex(text);
+        if (index < 0) {
+            return -1;
+        }
+        width += atlas->glyphs[index].width;
+    }
+    return width;
+}
+
+int32_t GlyphAtlas::fontHeight(uint8_t textSize) {
+    Face* atlas = face(textSize);
+    return atlas ? atlas->height : -1;
+}
+
+bool GlyphAtlas::drawString(lgfx::LovyanGFX& target, const char* text, int32_t x, int32_t y,
+                            uint8_t textSize, uint16_t textColor, uint16_t bgColor) {
+    if (textWidth(text, textSize) < 0) {
+        return false;
+    }
+    const Face& atlas = *face(textSize);
+    while (*text != '\0') {
+        const Glyph& glyph = atlas.glyphs[glyphIndex(text)];
+        target.drawBitmap(x, y, atlas.bits.data() + glyph.offset, glyph.width, atlas.height,
+                          textColor, bgColor);
+        x += glyph.width;
+    }
+    return true;
+}
+
+GlyphAtlas::Face* GlyphAtlas::face(uint8_t textSize) {
+    if (!enabled_ || textSize == 0 || textSize > MAX_TEXT_SIZE) {
+        return nullptr;
+    }
+    Face& face = faces_[textSize - 1];
+    if (!face.built) {
+        build(face, textSize);
+    }
+    return face.built ? &face : nullptr;
+}
+
+void GlyphAtlas::build(Face& face, uint8_t textSize) {
+    // Let the font engine draw each character once and keep the pixels it set
+    LGFX_Sprite cell(&display_);
+    cell.setColorDepth(16);
+    cell.setTextSize(textSize);
+    cell.setTextDatum(TL_DATUM);
+    face.height = cell.fontHeight();
+
+    char text[3];
+    int32_t cellWidth = 0;
+    for (size_t i = 0; i < CHARSET_SIZE; i++) {
+        encodeUtf8(CHARSET[i], text);
+        cellWidth = std::max(cellWidth, cell.textWidth(text));
+    }
+    if (cell.createSprite(cellWidth, face.height) == nullptr) {
+        return;  // Not built, the next use tries again
+    }
+
+    face.glyphs.clear();
+    face.bits.clear();
+    for (size_t i = 0; i < CHARSET_SIZE; i++) {
+        encodeUtf8(CHARSET[i], text);
+        Glyph glyph = {static_cast<uint8_t>(cell.textWidth(text)),
+                       static_cast<uint32_t>(face.bits.size())};
+        cell.fillSprite(TFT_BLACK);
+        cell.setTextColor(TFT_WHITE, TFT_BLACK);
+        cell.drawString(text, 0, 0);
+
+        size_t rowBytes = (glyph.width + 7) / 8;
+        face.bits.resize(face.bits.size() + rowBytes * face.height, 0);
+        uint8_t* row = face.bits.data() + glyph.offset;
+        for (int32_t y = 0; y < face.height; y++, row += rowBytes) {
+            for (int32_t x = 0; x < glyph.width; x++) {
+                if (cell.readPixel(x, y) != 0) {
+                    row[x / 8] |= 0x80 >> (x % 8);
+                }
+            }
+        }
+        face.glyphs.push_back(glyph);
+    }
+    face.built = true;
+}
+
+int GlyphAtlas::glyphIndex(const char*& text) const {
+    uint16_t code = static_cast<uint8_t>(*text++);
+    // Two byte UTF-8 sequences cover the rest of Latin-1
+    if ((code & 0xE0) == 0xC0 && (static_cast<uint8_t>(*text) & 0xC0) == 0x80) {
+        code = ((code & 0x1F) << 6) | (static_cast<uint8_t>(*text++) & 0x3F);
+    } else if (code >= 0x80) {
+        return -1;
+    }
+    return code <= 0xFF ? index_[code] : -1;
+}
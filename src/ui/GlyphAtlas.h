@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "config/LgfxConfig.h"
+
+/**
+ * Pre-rasterized glyphs of the default font for numbers: digits, signs and
+ * the unit symbols the widgets show. The font is a plain bitmap font, so a
+ * glyph is a 1 bit mask and one face per text size serves every colour pair,
+ * the colours are given when the mask is drawn. Faces are rasterized the
+ * first time a size is used and kept for the life of the application.
+ *
+ * Text with a character the atlas lacks is left to the font engine, callers
+ * check the result and draw it with drawString() then. A disabled atlas lacks
+ * everything, so all text takes that path and the two can be compared in the
+ * screen draw times.
+ */
+class GlyphAtlas {
+ public:
+    static constexpr uint8_t MAX_TEXT_SIZE = 4;
+
+    GlyphAtlas(LGFX& display, bool enabled);
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    // Width of text at textSize, -1 if the atlas lacks a character or the size
+    int32_t textWidth(const char* text, uint8_t textSize);
+    int32_t fontHeight(uint8_t textSize);
+
+    /**
+     * Draws text with its top left corner at (x, y). Draws nothing and returns
+     * false if textWidth() would be -1.
+     */
+    bool drawString(lgfx::LovyanGFX& target, const char* text, int32_t x, int32_t y,
+                    uint8_t textSize, uint16_t textColor, uint16_t bgColor);
+
+ private:
+    struct Glyph {
+        uint8_t width;    // The advance, the mask includes the spacing
+        uint32_t offset;  // Into Face::bits, rows padded to whole bytes
+    };
+    struct Face {
+        bool built = false;
+        uint8_t height = 0;
+        std::vector<Glyph> glyphs;  // In CHARSET order
+        std::vector<uint8_t> bits;
+    };
+
+    Face* face(uint8_t textSize);
+    void build(Face& face, uint8_t textSize);
+    // Index into CHARSET of the next character, -1 if missing; advances text
+    int glyphIndex(const char*& text) const;
+
+    LGFX& display_;
+    bool enabled_;
+    std::array<Face, MAX_TEXT_SIZE> faces_;
+    std::array<int8_t, 256> index_;  // Latin-1 code point to CHARSET index, -1 if missing
+};
@@ -0,0 +1,110 @@
+#include "PanelPusher.h"
+
+#include <esp_heap_caps.h>
+
+#include <algorithm>
+#include <cstring>
+
+PanelPusher::PanelPusher(LGFX& display, size_t bufferCount, size_t bufferBytes)
+    : display_(display), bufferPixels_(bufferBytes / sizeof(uint16_t)) {
+    for (size_t i = 0; i < bufferCount && bufferPixels_ > 0; i++) {
+        auto* pixels = static_cast<uint16_t*>(
+            heap_caps_malloc(bufferPixels_ * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_8BIT));
+        if (pixels == nullptr) {
+            break;
+        }
+        buffers_.push_back({pixels, false});
+    }
+    // One buffer would be refilled while still on the bus every time, that is just synchronous
+    if (buffers_.size() < 2) {
+        for (StagingBuffer& buffer : buffers_) {
+            heap_caps_free(buffer.pixels);
+        }
+        buffers_.clear();
+    }
+}
+
+PanelPusher::~PanelPusher() {
+    if (isAsync()) {
+        display_.waitDMA();
+    }
+    for (StagingBuffer& buffer : buffers_) {
+        heap_caps_free(buffer.pixels);
+    }
+}
+
+void PanelPusher::push(LGFX_Sprite& sprite, int32_t spriteX, int32_t spriteY,
+                       const DamageRegion::Rect& rect) {
+    if (!isAsync() || rect.width > bufferPixels_) {
+        pushSync(sprite, spriteX, spriteY, rect);
+        return;
+    }
+
+    // 16 bit sprites hold pixels in the panel's byte order, rows copy as they are
+    const auto* source = static_cast<const uint16_t*>(sprite.getBuffer());
+    const int32_t stride = sprite.width();
+    const uint16_t bandRows = std::min<size_t>(bufferPixels_ / rect.width, rect.height);
+
+    for (uint16_t row = 0; row < rect.height; row += bandRows) {
+        uint16_t rows = std::min<uint16_t>(bandRows, rect.height - row);
+        StagingBuffer& buffer = acquireBuffer();
+        for (uint16_t i = 0; i < rows; i++) {
+            int32_t y = rect.y - spriteY + row + i;
+            memcpy(buffer.pixels + i * rect.width, source + y * stride + (rect.x - spriteX),
+                   rect.width * sizeof(uint16_t));
+        }
+
+        // Starting a transfer waits for the one before it, the bus runs one at a time
+        unsigned long start = micros();
+        display_.pushImageDMA(rect.x, rect.y + row, rect.width, rows,
+                              reinterpret_cast<const lgfx::swap565_t*>(buffer.pixels));
+        busTimeUs_ += micros() - start;
+        for (StagingBuffer& other : buffers_) {
+            other.inFlight = false;
+        }
+        buffer.inFlight = true;
+    }
+}
+
+void PanelPusher::waitIdle() {
+    if (!isAsync()) {
+        return;
+    }
+    unsigned long start = micros();
+    display_.waitDMA();
+    busTimeUs_ += micros() - start;
+    for (StagingBuffer& buffer : buffers_) {
+        buffer.inFlight = false;
+    }
+}
+
+uint32_t PanelPusher::takeBusTimeUs() {
+    uint32_t busTimeUs = busTimeUs_;
+    busTimeUs_ = 0;
+    return busTimeUs;
+}
+
+uint32_t PanelPusher::takeDirectTimeUs() {
+    uint32_t directTimeUs = directTimeUs_;
+    directTimeUs_ = 0;
+    return directTimeUs;
+}
+
+void PanelPusher::pushSync(LGFX_Sprite& sprite, int32_t spriteX, int32_t spriteY,
+                           const DamageRegion::Rect& rect) {
+    waitIdle();
+    unsigned long start = micros();
+    display_.setClipRect(rect.x, rect.y, rect.width, rect.height);
+    sprite.pushSprite(&display_, spriteX, spriteY);
+    display_.clearClipRect();
+    busTimeUs_ += micros() - start;
+}
+
+PanelPusher::StagingBuffer& PanelPusher::acquireBuffer() {
+    StagingBuffer& buffer = buffers_[next_];
+    next_ = (next_ + 1) % buffers_.size();
+    if (buffer.inFlight) {
+        waitIdle();
+    }
+    return buffer;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "config/LgfxConfig.h"
+#include "ui/DamageRegion.h"
+
+/**
+ * Sends regions of off-screen sprites to the panel by DMA. Each region is
+ * copied, a band of rows at a time, into a ring of staging buffers in
+ * internal RAM and queued with pushImageDMA(), so the CPU fills the next
+ * band, or composes the next widget, while the previous one is still on
+ * the bus. LovyanGFX starts a transfer only once the one before it is done,
+ * so just the newest buffer can be in flight, and refilling it waits for the
+ * bus first. With fewer than two buffers every push is synchronous.
+ *
+ * Time spent blocked on the bus (those waits, and whole pushes when there
+ * are no staging buffers and pushing is synchronous) is summed up for the
+ * frame metrics. Widgets without a sprite draw on the panel directly, CPU
+ * and bus work interleaved per pixel run, so their time cannot be split and
+ * is summed up on its own. Everything else the screen task does counts as
+ * CPU time.
+ *
+ * Calls must be inside the display's startWrite()/endWrite().
+ */
+class PanelPusher {
+ public:
+    PanelPusher(LGFX& display, size_t bufferCount, size_t bufferBytes);
+    ~PanelPusher();
+
+    PanelPusher(const PanelPusher&) = delete;
+    PanelPusher& operator=(const PanelPusher&) = delete;
+
+    /**
+     * Queues rect (screen coordinates) of sprite, whose top left corner is at
+     * (spriteX, spriteY) on the screen
+     */
+    void push(LGFX_Sprite& sprite, int32_t spriteX, int32_t spriteY,
+              const DamageRegion::Rect& rect);
+
+    /**
+     * Waits until everything queued is on the panel, before drawing on the
+     * panel directly and at the end of a frame
+     */
+    void waitIdle();
+
+    bool isAsync() const { return !buffers_.empty(); }
+
+    // Bus time summed up since the last call
+    uint32_t takeBusTimeUs();
+
+    // Time of a widget drawing on the panel directly, summed up until taken
+    void addDirectTimeUs(uint32_t us) { directTimeUs_ += us; }
+    uint32_t takeDirectTimeUs();
+
+ private:
+    struct StagingBuffer {
+        uint16_t* pixels;
+        bool inFlight;
+    };
+
+    void pushSync(LGFX_Sprite& sprite, int32_t spriteX, int32_t spriteY,
+                  const DamageRegion::Rect& rect);
+    StagingBuffer& acquireBuffer();
+
+    LGFX& display_;
+    std::vector<StagingBuffer> buffers_;  // Empty when they could not be allocated
+    size_t bufferPixels_ = 0;
+    size_t next_ = 0;
+    uint32_t busTimeUs_ = 0;
+    uint32_t directTimeUs_ = 0;
+};
@@ -1,5 +1,19 @@
 #include "TouchManager.h"
 
+#ifndef NATIVE_BUILD
+namespace {
+TaskHandle_t touchWakeTask = nullptr;
+
+void IRAM_ATTR onTouchInterrupt() {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(touchWakeTask, &woken);
+    if (woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+}  // namespace
+#endif
+
 TouchManager::TouchManager(LGFX& display, LoggerInterface& logger, AppConfigInterface& config)
     : display_(display),
       logger_(logger),
@@ -16,7 +30,8 @@ TouchManager::TouchPoint TouchManager::readTouch() {
 
     // Read touch coordinates from display
     int32_t x = 0, y = 0;
-    if (!display_.getTouch(&x, &y)) {
+    touchActive_ = display_.getTouch(&x, &y);
+    if (!touchActive_) {
         return TouchPoint();  // No touch detected
     }
 
@@ -47,6 +62,36 @@ void TouchManager::resetDebounce() {
     logger_.debug("[TouchManager] Debounce timer reset");
 }
 
+void TouchManager::wakeOnTouch(TaskHandle_t task) {
+#ifndef NATIVE_BUILD
+    lgfx::ITouch* touch = display_.touch();
+    int16_t pin = touch ? touch->config().pin_int : -1;
+    if (wakesOnTouch_) {
+        detachInterrupt(digitalPinToInterrupt(pin));
+        wakesOnTouch_ = false;
+    }
+    if (task == nullptr) {
+        return;
+    }
+    if (pin < 0) {
+        logger_.warning("[TouchManager] No touch interrupt, polling the touch screen");
+        return;
+    }
+    // The controller pulls its interrupt line low when a finger comes down
+    touchWakeTask = task;
+    attachInterrupt(digitalPinToInterrupt(pin), onTouchInterrupt, FALLING);
+    wakesOnTouch_ = true;
+#endif
+}
+
+uint32_t TouchManager::msUntilPoll() const {
+    // A finger held through the debounce interval raises no new interrupt
+    if (!wakesOnTouch_ || touchActive_) {
+        return config_.getTimingScreenPollMs();
+    }
+    return UINT32_MAX;
+}
+
 unsigned long TouchManager::getTimeSinceLastTouch() const {
     return millis() - lastTouchTime_;
 }
\ No newline at end of file
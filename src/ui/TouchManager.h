@@ -1,5 +1,8 @@
 #pragma once
 
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
 #include <cstdint>
 
 #include "config/AppConfigInterface.h"
@@ -46,6 +49,18 @@ class TouchManager {
      */
     void resetDebounce();
 
+    /**
+     * Notifies task when the touch controller signals a new touch, nullptr stops. Without
+     * an interrupt pin (the native build) the touch screen is polled instead.
+     */
+    void wakeOnTouch(TaskHandle_t task);
+
+    /**
+     * Time until the touch screen has to be read again: never while idle with the
+     * interrupt set up, the poll interval while a finger is down or without it.
+     */
+    uint32_t msUntilPoll() const;
+
     /**
      * Get time since last touch (for debugging/diagnostics).
      */
@@ -58,6 +73,8 @@ class TouchManager {
 
     unsigned long lastTouchTime_;
     uint32_t debounceIntervalMs_;
+    bool touchActive_ = false;   // Finger down at the last read
+    bool wakesOnTouch_ = false;  // Interrupt set up
 
     bool shouldDebounce() const;
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "UIController.h"
 
+#include <algorithm>
+
 #include "core/events/EventHandler.h"
 #include "screens/BootScreen.h"
 #include "screens/ScreenFactory.h"
@@ -7,18 +9,20 @@
 #include "widgetScreens/SettingsScreen.h"
 
 UiController::UiController(DisplayContext& context, DisplayManager* displayManager,
-                           ApplicationMetrics& systemMetrics, PcMetrics& pcMetrics,
+                           ApplicationMetrics& systemMetrics, PcMetricsHosts& pcMetricsHosts,
                            SystemState::ScreenState& screenState, AppConfigInterface& config)
     : context_(context),
       logger_(context.getLogger()),
       displayManager_(displayManager),
       systemMetrics_(systemMetrics),
-      pcMetrics_(pcMetrics),
+      pcMetricsHosts_(pcMetricsHosts),
       screenState_(screenState),
       config_(config),
       actionHandler_(std::make_unique<EventHandler>(this, context.getLogger())),
       touchManager_(
-          std::make_unique<TouchManager>(context.getDisplay(), context.getLogger(), config)) {
+          std::make_unique<TouchManager>(context.getDisplay(), context.getLogger(), config)),
+      panelPusher_(std::make_unique<PanelPusher>(
+          context.getDisplay(), config.getUiDmaBufferCount(), config.getUiDmaBufferBytes())) {
     if (!displayManager_) {
         throw std::invalid_argument("[UiController] DisplayManager pointer cannot be null");
     }
@@ -36,6 +40,9 @@ UiController::~UiController() {
 
 void UiController::initialize() {
     logger_.info("[UiController] Initializing UI");
+    if (!panelPusher_->isAsync()) {
+        logger_.warning("[UiController] No DMA staging buffers, sprites push synchronously");
+    }
     requestTransitionTo(ScreenName::BOOT);
 }
 
@@ -61,11 +68,14 @@ bool UiController::requestTransitionTo(ScreenName screenName) {
     // Reset touch debounce timer during transitions to prevent accidental touches
     touchManager_->resetDebounce();
 
+    if (screenTask_ != nullptr) {
+        xTaskNotifyGive(screenTask_);  // Requests can come from other tasks
+    }
     return true;
 }
 
 void UiController::updateDisplay() {
-    unsigned long startTime = millis();
+    unsigned long startTime = micros();
     if (activeTransition_.isActive) {
         processTransitionPhase();
 
@@ -80,7 +90,23 @@ void UiController::updateDisplay() {
         logger_.warning("[UiController] No screen to draw");
         requestTransitionTo(ScreenName::BOOT);  // Fallback to boot screen
     }
-    systemMetrics_.addScreenDrawTime(millis() - startTime);
+    uint32_t frameUs = micros() - startTime;
+    uint32_t busUs = std::min(panelPusher_->takeBusTimeUs(), frameUs);
+    uint32_t directUs = std::min(panelPusher_->takeDirectTimeUs(), frameUs - busUs);
+    systemMetrics_.addScreenDrawTime(frameUs - busUs - directUs, busUs, directUs);
+}
+
+void UiController::setScreenTask(TaskHandle_t task) {
+    screenTask_ = task;
+    touchManager_->wakeOnTouch(task);
+}
+
+uint32_t UiController::msUntilUpdate() const {
+    if (activeTransition_.isActive || !currentScreen_) {
+        return 0;
+    }
+    uint32_t pollMs = config_.getTimingScreenPollMs();
+    return std::min(currentScreen_->msUntilUpdate(pollMs), touchManager_->msUntilPoll());
 }
 
 bool UiController::tryAcquireDisplayLock() {
@@ -161,7 +187,7 @@ void UiController::loadAndActivateScreen() {
 
     std::unique_ptr<ScreenInterface> newScreen;
     newScreen = ScreenFactory::createScreen(activeTransition_.nextScreen, logger_, displayManager_,
-                                            pcMetrics_, this, config_);
+                                            pcMetricsHosts_, this, config_);
 
     if (newScreen) {
         currentScreen_ = std::move(newScreen);
@@ -6,7 +6,8 @@
 #include "core/state/SystemState.h"
 #include "DisplayContext.h"
 #include "DisplayManager.h"
-#include "services/pcMetrics/PcMetrics.h"
+#include "services/pcMetrics/PcMetricsHosts.h"
+#include "ui/PanelPusher.h"
 #include "ui/screens/ScreenInterface.h"
 #include "ui/screens/ScreenTypes.h"
 #include "ui/TouchManager.h"
@@ -22,7 +23,7 @@ class EventHandler;
 class UiController {
  public:
     explicit UiController(DisplayContext& context, DisplayManager* displayManager,
-                          ApplicationMetrics& systemMetrics, PcMetrics& pcMetrics,
+                          ApplicationMetrics& systemMetrics, PcMetricsHosts& pcMetricsHosts,
                           SystemState::ScreenState& screenState, AppConfigInterface& config);
     ~UiController();
 
@@ -31,6 +32,13 @@ class UiController {
     void updateDisplay();
     bool isTransitioning() const { return activeTransition_.isActive; }
 
+    /**
+     * Sets the task calling updateDisplay(), notified on touches and screen requests
+     */
+    void setScreenTask(TaskHandle_t task);
+    // How long that task can sleep before updateDisplay() has something to do
+    uint32_t msUntilUpdate() const;
+
     // Screen transition methods
     bool requestTransitionTo(ScreenName screenName);
     void requestScreen(ScreenName screenName) {
@@ -41,6 +49,8 @@ class UiController {
     // Display access methods
     DisplayContext& getDisplayContext() { return context_; }
     DisplayManager* getDisplayManager() const { return displayManager_; }
+    ApplicationMetrics& getSystemMetrics() { return systemMetrics_; }
+    PanelPusher& getPanelPusher() { return *panelPusher_; }
     bool tryAcquireDisplayLock();
     void releaseDisplayLock();
 
@@ -73,13 +83,15 @@ class UiController {
     DisplayManager* displayManager_;
     DisplayContext& context_;
     ApplicationMetrics& systemMetrics_;
-    PcMetrics& pcMetrics_;
+    PcMetricsHosts& pcMetricsHosts_;
     SystemState::ScreenState& screenState_;
     AppConfigInterface& config_;
 
     std::unique_ptr<ScreenInterface> currentScreen_;
     std::unique_ptr<EventHandler> actionHandler_;
     std::unique_ptr<TouchManager> touchManager_;
+    std::unique_ptr<PanelPusher> panelPusher_;
+    TaskHandle_t screenTask_ = nullptr;
     SemaphoreHandle_t displayAccessMutex_;
 
     ScreenTransition activeTransition_;
@@ -1,4 +1,4 @@
-#include "UiController.h"
+#include "UIController.h"
 
 void UiController::processTouchInput() {
     // Use TouchManager to read and validate touch
@@ -1,9 +1,19 @@
 #include "WidgetManager.h"
 
+#include <esp_heap_caps.h>
 #include <esp_task_wdt.h>
 
-WidgetManager::WidgetManager(DisplayContext& context)
-    : logger_(context.getLogger()), lcd_(&context.getDisplay()), context_(context) {
+#include <algorithm>
+
+WidgetManager::WidgetManager(DisplayContext& context, ApplicationMetrics& systemMetrics,
+                             PanelPusher& pusher, AppConfigInterface& config)
+    : logger_(context.getLogger()),
+      systemMetrics_(systemMetrics),
+      pusher_(pusher),
+      config_(config),
+      lcd_(&context.getDisplay()),
+      context_(context),
+      damage_(context.getDisplay().width(), context.getDisplay().height()) {
     if (!lcd_) {
         logger_.error("WidgetManager created with null LGFX pointer!");
     }
@@ -14,12 +24,15 @@ WidgetManager::~WidgetManager() {
     cleanupWidgets();
 }
 
-void WidgetManager::addWidget(std::unique_ptr<WidgetInterface> widget) {
+void WidgetManager::addWidget(std::unique_ptr<WidgetInterface> widget, size_t spriteBudget) {
     if (!widget) {
         logger_.error("Null widget rejected");
         return;
     }
-    widgets_.push_back(std::move(widget));
+    ManagedWidget entry;
+    entry.widget = std::move(widget);
+    entry.spriteBudget = spriteBudget;
+    widgets_.push_back(std::move(entry));
     // logger_.debugf("[Heap] Widget post-add: %d", ESP.getFreeHeap());
 }
 
@@ -30,13 +43,29 @@ void WidgetManager::initializeWidgets() {
     }
     // logger_.debugf("Initializing %d widgets", widgets_.size());
 
+    uint32_t spriteCount = 0;
+    uint32_t spriteBytes = 0;
     lcd_->startWrite();
-    for (auto& widget : widgets_) {
-        widget->initialize(context_);
-        widget->drawStatic();
-        widget->draw(true);
+    for (ManagedWidget& entry : widgets_) {
+        createSprite(entry);
+        if (!entry.sprite) {
+            pusher_.waitIdle();
+        }
+        entry.widget->initialize(context_);
+        unsigned long drawStart = micros();
+        entry.widget->drawStatic();
+        entry.widget->draw(true);
+        if (entry.sprite) {
+            pushSprite(entry, true);
+            spriteCount++;
+            spriteBytes += entry.sprite->bufferLength();
+        } else {
+            pusher_.addDirectTimeUs(micros() - drawStart);
+        }
     }
+    pusher_.waitIdle();
     lcd_->endWrite();
+    systemMetrics_.setScreenSprites(spriteCount, spriteBytes, widgets_.size() - spriteCount);
 
     // logger_.debug("Widgets initialized");
     isInitialized_ = true;
@@ -55,19 +84,111 @@ void WidgetManager::updateAndDrawWidgets(bool forceRedraw) {
         return;
     }
 
-    lcd_->startWrite();
-    for (auto& widget : widgets_) {
-        bool needsDraw = forceRedraw || widget->needsUpdate();
-        if (needsDraw) {
-            // logger_.debugf("Drawing widget at (%d, %d)", widget->getDimensions().x,
-            //                 widget->getDimensions().y);
-            if (forceRedraw) {
-                widget->drawStatic();
-            }
-            widget->draw(forceRedraw);
+    damage_.clear();
+    if (forceRedraw) {
+        damage_.addAll();
+    }
+    for (ManagedWidget& entry : widgets_) {
+        entry.updating = forceRedraw;
+        if (!forceRedraw) {
+            uint32_t before = damage_.reportedPixels();
+            entry.widget->collectDamage(damage_);
+            entry.updating = damage_.reportedPixels() != before;
         }
     }
+    if (damage_.empty()) {
+        return;
+    }
+
+    lcd_->startWrite();
+    drawDamage(forceRedraw);
+    pusher_.waitIdle();
     lcd_->endWrite();
+
+    systemMetrics_.addScreenDamage(damage_.reportedPixels(), damage_.pixelCount());
+}
+
+void WidgetManager::createSprite(ManagedWidget& entry) {
+    WidgetInterface::Dimensions dims = entry.widget->getDimensions();
+    size_t bytes = size_t(dims.width) * dims.height * sizeof(uint16_t);
+    if (entry.spriteBudget < bytes) {
+        return;
+    }
+    // Leave PSRAM for the rest of the application, the widget still works without
+    size_t reserve = config_.getUiSpritePsramReserveBytes();
+    if (heap_caps_get_free_size(MALLOC_CAP_SPIRAM) < bytes + reserve) {
+        logger_.warningf("No PSRAM for a %ux%u widget sprite, drawing direct", dims.width,
+                         dims.height);
+        return;
+    }
+
+    auto sprite = std::make_unique<LGFX_Sprite>(lcd_);
+    sprite->setPsram(true);
+    sprite->setColorDepth(16);
+    if (sprite->createSprite(dims.width, dims.height) == nullptr) {
+        logger_.warningf("Widget sprite %ux%u failed, drawing direct", dims.width, dims.height);
+        return;
+    }
+    sprite->fillSprite(TFT_BLACK);
+    entry.widget->setSurface(sprite.get(), dims.x, dims.y);
+    entry.sprite = std::move(sprite);
+}
+
+void WidgetManager::drawDamage(bool forceRedraw) {
+    for (ManagedWidget& entry : widgets_) {
+        WidgetInterface& widget = *entry.widget;
+        WidgetInterface::Dimensions bounds = widget.getDimensions();
+        DamageRegion::Rect clip = damage_.boundsWithin(bounds);
+        if (DamageRegion::area(clip) == 0) {
+            continue;
+        }
+        if (entry.sprite) {
+            entry.sprite->setClipRect(clip.x - bounds.x, clip.y - bounds.y, clip.width,
+                                      clip.height);
+        } else {
+            // Queued pushes may still cover this area
+            pusher_.waitIdle();
+            lcd_->setClipRect(clip.x, clip.y, clip.width, clip.height);
+        }
+        unsigned long drawStart = micros();
+
+        // Without an update of its own it is damaged by a widget it overlaps
+        if (forceRedraw || !entry.updating) {
+            widget.drawStatic();
+            widget.draw(true);
+        } else {
+            widget.draw(false);
+        }
+
+        if (entry.sprite) {
+            entry.sprite->clearClipRect();
+            pushSprite(entry, false);
+        } else {
+            lcd_->clearClipRect();  // DMA pushes are not clipped by the panel
+            pusher_.addDirectTimeUs(micros() - drawStart);
+        }
+    }
+}
+
+void WidgetManager::pushSprite(ManagedWidget& entry, bool whole) {
+    WidgetInterface::Dimensions bounds = entry.widget->getDimensions();
+    if (whole) {
+        DamageRegion::Rect screen = {0, 0, static_cast<uint16_t>(lcd_->width()),
+                                     static_cast<uint16_t>(lcd_->height())};
+        DamageRegion::Rect visible = DamageRegion::intersect(bounds, screen);
+        if (DamageRegion::area(visible) > 0) {
+            pusher_.push(*entry.sprite, bounds.x, bounds.y, visible);
+        }
+        return;
+    }
+    // Each damaged rectangle is sent as a single block
+    for (const DamageRegion::Rect& rect : damage_) {
+        DamageRegion::Rect part = DamageRegion::intersect(rect, bounds);
+        if (DamageRegion::area(part) == 0) {
+            continue;
+        }
+        pusher_.push(*entry.sprite, bounds.x, bounds.y, part);
+    }
 }
 
 bool WidgetManager::handleTouch(uint16_t x, uint16_t y) {
@@ -89,7 +210,7 @@ bool WidgetManager::handleTouch(uint16_t x, uint16_t y) {
     // logger_.debugf("Checking %d widgets for touch at (%d,%d)", widgets_.size(), x, y);
 
     for (auto it = widgets_.rbegin(); it != widgets_.rend(); ++it) {
-        auto& widget = *it;
+        auto& widget = it->widget;
         WidgetInterface::Dimensions dims = widget->getDimensions();
 
         if (x >= dims.x && x < (dims.x + dims.width) && y >= dims.y && y < (dims.y + dims.height)) {
@@ -104,16 +225,28 @@ bool WidgetManager::handleTouch(uint16_t x, uint16_t y) {
     return false;
 }
 
+uint32_t WidgetManager::msUntilUpdate() const {
+    uint32_t earliest = UINT32_MAX;
+    if (!isInitialized_) {
+        return earliest;
+    }
+    for (const ManagedWidget& entry : widgets_) {
+        earliest = std::min(earliest, entry.widget->msUntilUpdate());
+    }
+    return earliest;
+}
+
 void WidgetManager::cleanupWidgets() {
     // logger_.debugf("Clearing %d widgets", widgets_.size());
 
     isInitialized_ = false;  // Mark as uninitialized before cleanup
 
-    for (auto& widget : widgets_) {
-        if (widget) {
-            widget->cleanUp();  // Ensure all widgets clean up their resources
-            widget.reset();     // Explicitly release
+    for (ManagedWidget& entry : widgets_) {
+        if (entry.widget) {
+            entry.widget->cleanUp();  // Ensure all widgets clean up their resources
+            entry.widget.reset();     // Explicitly release
         }
+        entry.sprite.reset();  // Gives the PSRAM back
     }
 
     widgets_.clear();  // Then clear the container
@@ -3,27 +3,70 @@
 #include <memory>
 #include <vector>
 
+#include "config/AppConfigInterface.h"
 #include "config/LgfxConfig.h"
+#include "ui/DamageRegion.h"
 #include "ui/DisplayContext.h"
+#include "ui/PanelPusher.h"
 #include "ui/widgets/WidgetInterface.h"
+#include "utils/ApplicationMetrics.h"
 #include "utils/LoggerInterface.h"
 
+/**
+ * Owns the widgets of a screen and composes their updates. Each frame the
+ * widgets report the areas they are about to change, the manager merges
+ * those into a DamageRegion and draws every widget touching it, in the
+ * order added, with the panel clipped to the damage inside the widget. A
+ * widget that only lies under (or over) another one's damage is redrawn in
+ * full there, so overlapping widgets stay stacked correctly.
+ *
+ * A widget given a sprite budget that covers its size draws into its own
+ * PSRAM sprite instead, and each damaged rectangle is pushed from there in
+ * one block, so the panel never shows a half drawn value. Without the
+ * budget, or when PSRAM is short, it draws on the panel as above.
+ *
+ * Sprite pushes go through the PanelPusher, so they stay on the bus while
+ * the next widget composes into its sprite. Drawing on the panel directly,
+ * and the end of a frame, wait for them.
+ */
 class WidgetManager {
  public:
-    explicit WidgetManager(DisplayContext& context);
+    WidgetManager(DisplayContext& context, ApplicationMetrics& systemMetrics,
+                  PanelPusher& pusher, AppConfigInterface& config);
     ~WidgetManager();
 
-    void addWidget(std::unique_ptr<WidgetInterface> widget);
+    /**
+     * Adds a widget drawn above those added before. With spriteBudget at least its size
+     * in RGB565 bytes, it gets an off-screen sprite when initialized.
+     */
+    void addWidget(std::unique_ptr<WidgetInterface> widget, size_t spriteBudget = 0);
     void initializeWidgets();
     void updateAndDrawWidgets(bool forceRedraw = false);
     bool handleTouch(uint16_t x, uint16_t y);
+    // Earliest msUntilUpdate() of the widgets
+    uint32_t msUntilUpdate() const;
     void cleanupWidgets();
     size_t getWidgetCount() const { return widgets_.size(); }
 
  private:
+    struct ManagedWidget {
+        std::unique_ptr<WidgetInterface> widget;
+        size_t spriteBudget = 0;
+        std::unique_ptr<LGFX_Sprite> sprite;  // Null when drawing on the panel
+        bool updating = false;                // Reported damage this frame
+    };
+
+    void createSprite(ManagedWidget& entry);
+    void drawDamage(bool forceRedraw);
+    void pushSprite(ManagedWidget& entry, bool whole);
+
     DisplayContext& context_;
     LoggerInterface& logger_;
+    ApplicationMetrics& systemMetrics_;
+    PanelPusher& pusher_;
+    AppConfigInterface& config_;
     LGFX* lcd_;
-    std::vector<std::unique_ptr<WidgetInterface>> widgets_;
+    std::vector<ManagedWidget> widgets_;
+    DamageRegion damage_;
     bool isInitialized_ = false;
 };
\ No newline at end of file
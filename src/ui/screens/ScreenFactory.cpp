@@ -6,7 +6,7 @@
 
 std::unique_ptr<ScreenInterface>
 ScreenFactory::createScreen(ScreenName name, LoggerInterface& logger, DisplayManager* display,
-                            PcMetrics& metrics, UiController* controller,
+                            PcMetricsHosts& metrics, UiController* controller,
                             AppConfigInterface& config) {
     switch (name) {
         case ScreenName::BOOT:
@@ -3,16 +3,16 @@
 #include "config/AppConfigInterface.h"
 #include "ScreenInterface.h"
 #include "ui/screens/ScreenTypes.h"
-#include "ui/UiController.h"
+#include "ui/UIController.h"
 
 class LoggerInterface;
 class DisplayManager;
-class PcMetrics;
+class PcMetricsHosts;
 class UIController;
 
 class ScreenFactory {
  public:
     static std::unique_ptr<ScreenInterface>
     createScreen(ScreenName name, LoggerInterface& logger, DisplayManager* display,
-                 PcMetrics& metrics, UiController* controller, AppConfigInterface& config);
+                 PcMetricsHosts& metrics, UiController* controller, AppConfigInterface& config);
 };
\ No newline at end of file
@@ -12,4 +12,8 @@ class ScreenInterface {
     virtual void onEnter() {}  // Optional
     virtual void onExit() {}   // Optional
     virtual void handleTouch(uint16_t x, uint16_t y) {}
+
+    // Time until draw() has something new without a wakeup event (new metrics, a touch).
+    // Screens that cannot tell are polled every pollMs.
+    virtual uint32_t msUntilUpdate(uint32_t pollMs) const { return pollMs; }
 };
\ No newline at end of file
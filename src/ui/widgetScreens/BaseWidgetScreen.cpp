@@ -5,7 +5,8 @@ BaseWidgetScreen::BaseWidgetScreen(LoggerInterface& logger, UiController* uiCont
     : logger_(logger),
       lcd_(uiController->getDisplayManager()->getDisplay()),
       uiController_(uiController),
-      widgetManager_(uiController->getDisplayContext()),
+      widgetManager_(uiController->getDisplayContext(), uiController->getSystemMetrics(),
+                     uiController->getPanelPusher(), config),
       config_(config) {}
 
 BaseWidgetScreen::~BaseWidgetScreen() {
@@ -37,6 +38,10 @@ void BaseWidgetScreen::handleTouch(uint16_t x, uint16_t y) {
     widgetManager_.handleTouch(x, y);
 }
 
+uint32_t BaseWidgetScreen::msUntilUpdate(uint32_t pollMs) const {
+    return widgetManager_.msUntilUpdate();
+}
+
 void BaseWidgetScreen::handleAction(EventType action) {
     EventBus::getInstance().publish(action);
 }
\ No newline at end of file
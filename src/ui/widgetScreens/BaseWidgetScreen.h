@@ -3,7 +3,7 @@
 #include "config/AppConfigInterface.h"
 #include "core/events/EventBus.h"
 #include "ui/screens/ScreenInterface.h"
-#include "ui/UiController.h"
+#include "ui/UIController.h"
 #include "ui/WidgetManager.h"
 #include "utils/Logger.h"
 
@@ -17,6 +17,7 @@ class BaseWidgetScreen : public ScreenInterface {
     void onExit() override;
     void draw() override;
     void handleTouch(uint16_t x, uint16_t y) override;
+    uint32_t msUntilUpdate(uint32_t pollMs) const override;
 
  protected:
     virtual void createWidgets() = 0;  // Pure virtual to force derived classes to implement
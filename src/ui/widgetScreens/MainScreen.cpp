@@ -1,16 +1,30 @@
 #include "MainScreen.h"
 
-MainScreen::MainScreen(LoggerInterface& logger, PcMetrics& pcMetrics, UiController* uiController,
-                       AppConfigInterface& config)
-    : BaseWidgetScreen(logger, uiController, config), pcMetrics_(pcMetrics) {}
+MainScreen::MainScreen(LoggerInterface& logger, PcMetricsHosts& pcMetricsHosts,
+                       UiController* uiController, AppConfigInterface& config)
+    : BaseWidgetScreen(logger, uiController, config), pcMetricsHosts_(pcMetricsHosts) {}
 
 void MainScreen::createWidgets() {
-    widgetManager_.addWidget(std::unique_ptr<PcMetricsWidget>(new PcMetricsWidget(
-        uiController_->getDisplayContext(), {0, 0, 480, 180}, 100, pcMetrics_, config_)));
+    // Widgets that update draw off-screen if PSRAM allows, the button is only drawn once
+    const size_t spriteBudget = config_.getUiWidgetSpriteBytes();
 
-    widgetManager_.addWidget(std::unique_ptr<ClockWidget>(
-        new ClockWidget(uiController_->getDisplayContext(), {328, 288, 150, 24}, 1000,
-                        TFT_LIGHTGREY, TFT_BLACK, 3)));
+    widgetManager_.addWidget(
+        std::unique_ptr<PcMetricsWidget>(new PcMetricsWidget(
+            uiController_->getDisplayContext(), {0, 0, 480, 180}, 100, pcMetricsHosts_, config_)),
+        spriteBudget);
+
+    if (pcMetricsHosts_.count() > 1) {
+        widgetManager_.addWidget(
+            std::unique_ptr<HostSummaryWidget>(new HostSummaryWidget(
+                uiController_->getDisplayContext(), {0, 184, 480, 80}, 500, pcMetricsHosts_)),
+            spriteBudget);
+    }
+
+    widgetManager_.addWidget(
+        std::unique_ptr<ClockWidget>(new ClockWidget(uiController_->getDisplayContext(),
+                                                     {328, 288, 150, 24}, 1000, TFT_LIGHTGREY,
+                                                     TFT_BLACK, 3)),
+        spriteBudget);
 
     widgetManager_.addWidget(std::unique_ptr<ButtonWidget>(new ButtonWidget(
         uiController_->getDisplayContext(), "<", {0, 272, 48, 48}, 0, EventType::SHOW_SETTINGS,
@@ -2,18 +2,19 @@
 
 #include "BaseWidgetScreen.h"
 #include "config/AppConfigInterface.h"
-#include "services/pcMetrics/PcMetrics.h"
+#include "services/pcMetrics/PcMetricsHosts.h"
 #include "ui/widgets/ButtonWidget.h"
 #include "ui/widgets/ClockWidget.h"
+#include "ui/widgets/HostSummaryWidget.h"
 #include "ui/widgets/PcMetricsWidget.h"
 
 class MainScreen : public BaseWidgetScreen {
  public:
-    MainScreen(LoggerInterface& logger, PcMetrics& pcMetrics, UiController* uiController,
+    MainScreen(LoggerInterface& logger, PcMetricsHosts& pcMetricsHosts, UiController* uiController,
                AppConfigInterface& config);
     ~MainScreen() override = default;
 
  private:
     void createWidgets() override;
-    PcMetrics& pcMetrics_;
+    PcMetricsHosts& pcMetricsHosts_;
 };
\ No newline at end of file
@@ -5,8 +5,11 @@ SettingsScreen::SettingsScreen(LoggerInterface& logger, UiController* uiControll
     : BaseWidgetScreen(logger, uiController, config) {}
 
 void SettingsScreen::createWidgets() {
-    widgetManager_.addWidget(std::unique_ptr<ClockWidget>(new ClockWidget(
-        uiController_->getDisplayContext(), {328, 288, 150, 24}, 1000, TFT_YELLOW, TFT_BLACK, 3)));
+    widgetManager_.addWidget(
+        std::unique_ptr<ClockWidget>(new ClockWidget(uiController_->getDisplayContext(),
+                                                     {328, 288, 150, 24}, 1000, TFT_YELLOW,
+                                                     TFT_BLACK, 3)),
+        config_.getUiWidgetSpriteBytes());
     widgetManager_.addWidget(std::unique_ptr<ButtonWidget>(new ButtonWidget(
         uiController_->getDisplayContext(), "<", {0, 320 - 1 - 48, 48, 48}, 0, EventType::SHOW_MAIN,
         [this](EventType action) { this->handleAction(action); }, TFT_BLACK, TFT_WHITE)));
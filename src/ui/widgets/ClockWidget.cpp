@@ -2,6 +2,8 @@
 
 #include <time.h>
 
+#include "ui/DamageRegion.h"
+
 ClockWidget::ClockWidget(DisplayContext& context, const Dimensions& dims, uint32_t updateIntervalMs,
                          uint16_t textColor, uint16_t bgColor, uint8_t textSize,
                          const std::string& format)
@@ -11,6 +13,15 @@ ClockWidget::ClockWidget(DisplayContext& context, const Dimensions& dims, uint32
       textSize_(textSize),
       format_(format),
       context_(context) {
+    layoutSections();
+}
+
+void ClockWidget::setSurface(lgfx::LovyanGFX* surface, int16_t originX, int16_t originY) {
+    Widget::setSurface(surface, originX, originY);
+    layoutSections();
+}
+
+void ClockWidget::layoutSections() {
     // Calculate section widths (assuming format is HH:MM:SS)
     uint16_t totalWidth = dimensions_.width;
     uint16_t partWidth = (totalWidth - 2 * colonWidth_) / 3;  // Equal width for all parts
@@ -57,10 +68,49 @@ void ClockWidget::draw(bool forceRedraw) {
     if (!isInitialized_ || !lcd_)
         return;
 
-    struct tm timeinfo;
-    getLocalTime(&timeinfo, 5);
+    if (!timePending_) {
+        getLocalTime(&pendingTime_, 5);
+    }
+    timePending_ = false;
+
+    updateIfNeeded(pendingTime_, forceRedraw);
+}
 
-    updateIfNeeded(timeinfo, forceRedraw);
+uint32_t ClockWidget::msUntilUpdate() const {
+    if (!isInitialized_) {
+        return UINT32_MAX;
+    }
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    if (now.tv_sec != checkedSecond_) {
+        return 0;
+    }
+    return 1000 - now.tv_usec / 1000;
+}
+
+void ClockWidget::collectDamage(DamageRegion& damage) {
+    if (!isInitialized_) {
+        return;
+    }
+    // Once per wall clock second, the screen task wakes on it through msUntilUpdate()
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    if (now.tv_sec == checkedSecond_) {
+        return;
+    }
+    checkedSecond_ = now.tv_sec;
+    getLocalTime(&pendingTime_, 5);
+    timePending_ = true;
+
+    auto addIfChanged = [&](const TimeSection& section, int value) {
+        if (section.lastValue != value) {
+            addDamage(damage, {section.x, dimensions_.y, section.width, dimensions_.height});
+        }
+    };
+    addIfChanged(hours_, pendingTime_.tm_hour);
+    addIfChanged(mins_, pendingTime_.tm_min);
+    addIfChanged(secs_, pendingTime_.tm_sec);
+    lastUpdateTimeMs_ = millis();  // Checked, whether or not a digit changed
 }
 
 void ClockWidget::updateIfNeeded(struct tm& timeinfo, bool forceRedraw) {
@@ -92,10 +142,19 @@ void ClockWidget::updateIfNeeded(struct tm& timeinfo, bool forceRedraw) {
 
 void ClockWidget::drawTimePart(uint16_t x, uint16_t y, uint16_t width, const char* text) {
     lcd_->fillRect(x, y, width, dimensions_.height, bgColor_);
+    int16_t textY = y + dimensions_.height / 2 - (textSize_ * 8) / 2;
+
+    // Digits come from the glyph atlas, text sizes past it go through the font engine
+    GlyphAtlas& glyphs = context_.getGlyphs();
+    int32_t fontHeight = glyphs.fontHeight(textSize_);
+    if (fontHeight >= 0 && glyphs.drawString(*lcd_, text, x, textY - fontHeight / 2, textSize_,
+                                             textColor_, bgColor_)) {
+        return;
+    }
     lcd_->setTextColor(textColor_, bgColor_);
     lcd_->setTextSize(textSize_);
     lcd_->setTextDatum(CL_DATUM);
-    lcd_->drawString(text, x, y + dimensions_.height / 2 - (textSize_ * 8) / 2);
+    lcd_->drawString(text, x, textY);
 }
 
 bool ClockWidget::handleTouch(uint16_t x, uint16_t y) {
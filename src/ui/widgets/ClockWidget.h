@@ -1,5 +1,8 @@
 #pragma once
 
+#include <sys/time.h>
+#include <time.h>
+
 #include <string>
 
 #include "ui/widgets/Widget.h"
@@ -12,9 +15,14 @@ class ClockWidget : public Widget {
 
     void drawStatic() override;
     void draw(bool forceRedraw = false) override;
+    // Until the next wall clock second, not a fixed interval from the last check
+    uint32_t msUntilUpdate() const override;
     bool handleTouch(uint16_t x, uint16_t y) override;
+    void collectDamage(DamageRegion& damage) override;
+    void setSurface(lgfx::LovyanGFX* surface, int16_t originX, int16_t originY) override;
 
  private:
+    void layoutSections();
     void drawTimePart(uint16_t x, uint16_t y, uint16_t width, const char* text);
     void updateIfNeeded(struct tm& timeinfo, bool forceRedraw);
 
@@ -23,6 +31,11 @@ class ClockWidget : public Widget {
     uint8_t textSize_;
     std::string format_;
 
+    // Time read by collectDamage(), drawn by the next draw()
+    struct tm pendingTime_ = {};
+    bool timePending_ = false;
+    time_t checkedSecond_ = -1;  // Wall clock second of the last check
+
     // Time section dimensions
     struct TimeSection {
         uint16_t x;
@@ -0,0 +1,100 @@
+#include "HostSummaryWidget.h"
+
+#include "ui/DamageRegion.h"
+
+HostSummaryWidget::HostSummaryWidget(DisplayContext& context, const Dimensions& dims,
+                                     uint32_t updateIntervalMs, PcMetricsHosts& hosts)
+    : Widget(dims, updateIntervalMs),
+      context_(context),
+      hosts_(hosts),
+      lastGenerations_(hosts.count(), 0) {}
+
+void HostSummaryWidget::drawStatic() {
+    if (!isInitialized_ || !lcd_)
+        return;
+
+    lcd_->fillRect(dimensions_.x, dimensions_.y, dimensions_.width, dimensions_.height, TFT_BLACK);
+    isStaticDrawn_ = true;
+}
+
+void HostSummaryWidget::draw(bool forceRedraw) {
+    if (!isInitialized_ || !lcd_)
+        return;
+
+    uint8_t rows = min<uint8_t>(hosts_.count(), dimensions_.height / ROW_HEIGHT);
+    for (uint8_t host = 0; host < rows; host++) {
+        PcMetricsSnapshot& snapshot = hosts_.getSnapshot(host);
+        bool changed = rowsPending_ ? (pendingRows_ & (1u << host)) != 0
+                                    : snapshot.getGeneration() != lastGenerations_[host];
+        if (!forceRedraw && !changed) {
+            continue;
+        }
+
+        PcMetrics metrics;
+        lastGenerations_[host] = snapshot.read(metrics);
+        drawRow(host, metrics);
+    }
+    rowsPending_ = false;
+    lastUpdateTimeMs_ = millis();
+}
+
+void HostSummaryWidget::collectDamage(DamageRegion& damage) {
+    if (!needsUpdate()) {
+        return;
+    }
+    pendingRows_ = 0;
+    uint8_t rows = min<uint8_t>(hosts_.count(), dimensions_.height / ROW_HEIGHT);
+    for (uint8_t host = 0; host < rows; host++) {
+        if (hosts_.getSnapshot(host).getGeneration() != lastGenerations_[host]) {
+            pendingRows_ |= 1u << host;
+            uint16_t y = dimensions_.y + host * ROW_HEIGHT;
+            addDamage(damage, {dimensions_.x, y, dimensions_.width, ROW_HEIGHT});
+        }
+    }
+    rowsPending_ = true;
+}
+
+void HostSummaryWidget::drawRow(uint8_t host, const PcMetrics& metrics) {
+    const int16_t y = dimensions_.y + host * ROW_HEIGHT;
+
+    lcd_->fillRect(dimensions_.x, y, dimensions_.width, ROW_HEIGHT, TFT_BLACK);
+    lcd_->setTextSize(2);
+    lcd_->setTextDatum(TL_DATUM);
+
+    lcd_->setTextColor(metrics.is_available ? TFT_WHITE : TFT_DARKGREY, TFT_BLACK);
+    lcd_->drawString(hosts_.getName(host).c_str(), dimensions_.x + 2, y + 2);
+
+    if (!metrics.is_available) {
+        lcd_->drawString("offline", dimensions_.x + 220, y + 2);
+        return;
+    }
+
+    const char* labels[] = {"C ", "G ", "M "};
+    const SensorId ids[] = {SensorId::CPU_LOAD, SensorId::GPU_3D, SensorId::MEM_LOAD};
+    for (uint8_t i = 0; i < 3; i++) {
+        uint16_t load = metrics.get(ids[i]);
+        String text = labels[i] + String(load) + "%";
+        lcd_->setTextColor(context_.getColors().getColorFromPercent(load, false), TFT_BLACK);
+        lcd_->drawString(text.c_str(), dimensions_.x + 220 + i * 88, y + 2);
+    }
+}
+
+bool HostSummaryWidget::needsUpdate() const {
+    if (!isInitialized_) {
+        return false;
+    }
+    for (uint8_t host = 0; host < lastGenerations_.size(); host++) {
+        if (hosts_.getSnapshot(host).getGeneration() != lastGenerations_[host]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t HostSummaryWidget::msUntilUpdate() const {
+    return needsUpdate() ? 0 : UINT32_MAX;  // Publishing a sample wakes the screen
+}
+
+bool HostSummaryWidget::handleTouch(uint16_t x, uint16_t y) {
+    return false;  // No touch interaction
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "services/pcMetrics/PcMetricsHosts.h"
+#include "ui/DisplayContext.h"
+#include "ui/widgets/Widget.h"
+
+/**
+ * One row per LHM host with its CPU, GPU and RAM load, so every watched
+ * machine stays visible while PcMetricsWidget shows one of them in detail.
+ */
+class HostSummaryWidget : public Widget {
+ public:
+    HostSummaryWidget(DisplayContext& context, const Dimensions& dims, uint32_t updateIntervalMs,
+                      PcMetricsHosts& hosts);
+
+    void drawStatic() override;
+    void draw(bool forceRedraw = false) override;
+    bool handleTouch(uint16_t x, uint16_t y) override;
+    bool needsUpdate() const override;
+    uint32_t msUntilUpdate() const override;
+    void collectDamage(DamageRegion& damage) override;
+
+ private:
+    static constexpr uint16_t ROW_HEIGHT = 20;
+
+    DisplayContext& context_;
+    PcMetricsHosts& hosts_;
+    std::vector<uint32_t> lastGenerations_;
+
+    // Rows whose generation moved when collectDamage() ran, the only ones the next draw() redraws
+    uint32_t pendingRows_ = 0;
+    bool rowsPending_ = false;
+
+    void drawRow(uint8_t host, const PcMetrics& metrics);
+};
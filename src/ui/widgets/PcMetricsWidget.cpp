@@ -1,35 +1,69 @@
 #include "PcMetricsWidget.h"
 
+#include "ui/DamageRegion.h"
+
+namespace {
+struct ValueWidgetSpec {
+    SensorId id;
+    const char* label;
+    WidgetInterface::Dimensions dims;
+};
+
+// Single value widgets down the right edge
+constexpr ValueWidgetSpec kValueWidgets[] = {
+    {SensorId::CPU_LOAD, "CPU", {380, 0, 100, 20}},
+    {SensorId::GPU_3D, "3D", {380, 20, 100, 20}},
+    {SensorId::GPU_COMPUTE, "CMP", {380, 40, 100, 20}},
+};
+
+struct TextLineSpec {
+    SensorId id;
+    const char* label;
+    int16_t y;  // Offset from the widget top
+};
+
+// Plain text lines on the left, values in percent
+constexpr TextLineSpec kTextLines[] = {
+    {SensorId::GPU_MEM, "GPU RAM: ", 0},
+    {SensorId::MEM_LOAD, "RAM: ", 25},
+};
+constexpr uint16_t kTextLineHeight = 16;  // Text size 2
+
+// Host label between the text lines on the left and the single value widgets on the right,
+// x from the widget left
+constexpr int16_t kHostLabelX = 200;
+constexpr int16_t kHostLabelWidth = 176;
+constexpr int16_t kHostLabelHeight = 20;
+}  // namespace
+
 PcMetricsWidget::PcMetricsWidget(DisplayContext& context, const Dimensions& dims,
-                                 uint32_t updateIntervalMs, PcMetrics& pcMetrics,
+                                 uint32_t updateIntervalMs, PcMetricsHosts& hosts,
                                  AppConfigInterface& config)
-    : Widget(dims, updateIntervalMs), context_(context), pcMetrics_(pcMetrics), config_(config) {
+    : Widget(dims, updateIntervalMs), context_(context), hosts_(hosts), config_(config) {
     threadsWidget_ = std::make_unique<ThreadsWidget>(
-        context_, Dimensions{0, 125 - 65, 480, 55 + 65}, updateIntervalMs, pcMetrics_, config_);
-
-    cpuLoadWidget_ = std::make_unique<SingleValueWidget>(context_, Dimensions{380, 0, 100, 20},
-                                                         updateIntervalMs);
-    cpuLoadWidget_->setUnit("%");
-    cpuLoadWidget_->setRange(0, 100);
-    cpuLoadWidget_->setColorThresholds(0.5f, 0.75f, 1.0f);
-    cpuLoadWidget_->setLabel("CPU");
-    cpuLoadWidget_->setLabelWidth(44);
-
-    gpu3dWidget_ = std::make_unique<SingleValueWidget>(context_, Dimensions{380, 20, 100, 20},
-                                                       updateIntervalMs);
-    gpu3dWidget_->setUnit("%");
-    gpu3dWidget_->setRange(0, 100);
-    gpu3dWidget_->setColorThresholds(0.5f, 0.75f, 1.0f);
-    gpu3dWidget_->setLabel("3D");
-    gpu3dWidget_->setLabelWidth(44);
-
-    gpuComputeWidget_ = std::make_unique<SingleValueWidget>(context_, Dimensions{380, 40, 100, 20},
-                                                            updateIntervalMs);
-    gpuComputeWidget_->setUnit("%");
-    gpuComputeWidget_->setRange(0, 100);
-    gpuComputeWidget_->setColorThresholds(0.5f, 0.75f, 1.0f);
-    gpuComputeWidget_->setLabel("CMP");
-    gpuComputeWidget_->setLabelWidth(44);
+        context_, Dimensions{0, 125 - 65, 480, 55 + 65}, updateIntervalMs, pcMetrics_);
+
+    for (const ValueWidgetSpec& spec : kValueWidgets) {
+        auto widget = std::make_unique<SingleValueWidget>(context_, spec.dims, updateIntervalMs);
+        widget->setUnit(SensorValue::unitSymbol(SensorRegistry::find(spec.id)->unit));
+        widget->setRange(0, 100);
+        widget->setColorThresholds(0.5f, 0.75f, 1.0f);
+        widget->setLabel(spec.label);
+        widget->setLabelWidth(44);
+        valueWidgets_.push_back({spec.id, std::move(widget)});
+    }
+}
+
+void PcMetricsWidget::setSurface(lgfx::LovyanGFX* surface, int16_t originX, int16_t originY) {
+    Widget::setSurface(surface, originX, originY);
+
+    // Children draw into the same surface
+    if (threadsWidget_) {
+        threadsWidget_->setSurface(surface, originX, originY);
+    }
+    for (ValueBinding& binding : valueWidgets_) {
+        binding.widget->setSurface(surface, originX, originY);
+    }
 }
 
 void PcMetricsWidget::drawStatic() {
@@ -43,19 +77,9 @@ void PcMetricsWidget::drawStatic() {
         threadsWidget_->drawStatic();
     }
 
-    if (cpuLoadWidget_) {
-        cpuLoadWidget_->initialize(context_);
-        cpuLoadWidget_->drawStatic();
-    }
-
-    if (gpu3dWidget_) {
-        gpu3dWidget_->initialize(context_);
-        gpu3dWidget_->drawStatic();
-    }
-
-    if (gpuComputeWidget_) {
-        gpuComputeWidget_->initialize(context_);
-        gpuComputeWidget_->drawStatic();
+    for (ValueBinding& binding : valueWidgets_) {
+        binding.widget->initialize(context_);
+        binding.widget->drawStatic();
     }
 }
 
@@ -63,54 +87,41 @@ void PcMetricsWidget::draw(bool forceRedraw /* = false */) {
     if (!isInitialized_ || !lcd_)
         return;
 
-    bool needsRedraw = forceRedraw || needsUpdate();
-
-    if (needsRedraw && pcMetrics_.is_available) {  // TODO clear the area if not available
-        // lcd_->fillRect(dimensions_.x, dimensions_.y, dimensions_.width,
-        //                dimensions_.height, TFT_BLACK);
-
-        // Update CPU load widget
-        if (cpuLoadWidget_) {
-            cpuLoadWidget_->setValue(pcMetrics_.cpu_load);
-            cpuLoadWidget_->draw(forceRedraw);
+    if (forceRedraw) {
+        loadSample(true);
+    } else if (!samplePending_) {
+        if (!needsUpdate()) {
+            return;
         }
+        loadSample(false);
+    }
+    samplePending_ = false;
 
-        // Update GPU 3D widget
-        if (gpu3dWidget_) {
-            gpu3dWidget_->setValue(pcMetrics_.gpu_3d);
-            gpu3dWidget_->draw(forceRedraw);
-        }
+    if (labelDirty_) {
+        drawHostLabel();
+        labelDirty_ = false;
+    }
 
-        // Update GPU Compute widget
-        if (gpuComputeWidget_) {
-            gpuComputeWidget_->setValue(pcMetrics_.gpu_compute);
-            gpuComputeWidget_->draw(forceRedraw);
+    if (pcMetrics_.is_available) {  // TODO clear the area if not available
+        // lcd_->fillRect(dimensions_.x, dimensions_.y, dimensions_.width,
+        //                dimensions_.height, TFT_BLACK);
+        for (ValueBinding& binding : valueWidgets_) {
+            if (pcMetrics_.hasChanged(binding.id)) {
+                binding.widget->setValue(pcMetrics_.get(binding.id));
+                binding.widget->draw(true);
+            }
         }
 
         lcd_->setTextColor(TFT_WHITE, TFT_BLACK);
         lcd_->setTextSize(2);
         lcd_->setTextDatum(TL_DATUM);
 
-        // // Draw CPU Load
-        // String cpuLabel = "CPU: " + String(pcMetrics_.cpu_load) + "%  ";
-        // lcd_->drawString(cpuLabel.c_str(), dimensions_.x + 2, dimensions_.y + 0 + 2);
-
-        // // Draw GPU Load
-        // String gpu3D = "GPU 3D: " + String(pcMetrics_.gpu_3d) + "%  ";
-        // lcd_->drawString(gpu3D.c_str(), dimensions_.x + 2, dimensions_.y + 25 + 2);
-
-        // // Draw GPU Load
-        // String gpuCompute = "GPU Compute: " + String(pcMetrics_.gpu_compute) + "%  ";
-        // lcd_->drawString(gpuCompute.c_str(), dimensions_.x + 2, dimensions_.y + 50 +
-        // 2);
-
-        // Draw GPU mem
-        String gpuMem = "GPU RAM: " + String(pcMetrics_.gpu_mem) + "%  ";
-        lcd_->drawString(gpuMem.c_str(), dimensions_.x + 2, dimensions_.y + 0 + 2);
-
-        // Draw RAM Load
-        String ram = "RAM: " + String(pcMetrics_.mem_load) + "%  ";
-        lcd_->drawString(ram.c_str(), dimensions_.x + 2, dimensions_.y + 25 + 2);
+        for (const TextLineSpec& line : kTextLines) {
+            if (pcMetrics_.hasChanged(line.id)) {
+                String text = line.label + String(pcMetrics_.get(line.id)) + "%  ";
+                lcd_->drawString(text.c_str(), dimensions_.x + 2, dimensions_.y + line.y + 2);
+            }
+        }
 
         // Draw ThreadsWidget
         if (threadsWidget_) {
@@ -118,24 +129,120 @@ void PcMetricsWidget::draw(bool forceRedraw /* = false */) {
         }
 
         // last update of the data
-        lastUpdateTimestamp_ = pcMetrics_.last_update_timestamp;
+        lastDrawnGeneration_ = lastGeneration_;
 
         // last update of the widget
         lastUpdateTimeMs_ = millis();
     }
 }
 
+void PcMetricsWidget::collectDamage(DamageRegion& damage) {
+    if (!needsUpdate()) {
+        return;
+    }
+    loadSample(false);
+    uint32_t before = damage.reportedPixels();
+    addSampleDamage(damage);
+
+    // Nothing on screen changes, the sample counts as drawn
+    if (damage.reportedPixels() == before) {
+        samplePending_ = false;
+        labelDirty_ = false;
+        if (pcMetrics_.is_available) {
+            lastDrawnGeneration_ = lastGeneration_;
+        }
+    }
+}
+
+void PcMetricsWidget::addSampleDamage(DamageRegion& damage) {
+    if (labelDirty_ && hosts_.count() >= 2) {
+        addDamage(damage, {static_cast<uint16_t>(dimensions_.x + kHostLabelX), dimensions_.y,
+                           static_cast<uint16_t>(kHostLabelWidth),
+                           static_cast<uint16_t>(kHostLabelHeight)});
+    }
+    if (!pcMetrics_.is_available) {
+        return;
+    }
+
+    for (ValueBinding& binding : valueWidgets_) {
+        if (pcMetrics_.hasChanged(binding.id)) {
+            binding.widget->setValue(pcMetrics_.get(binding.id));
+            binding.widget->collectDamage(damage);
+        }
+    }
+    for (const TextLineSpec& line : kTextLines) {
+        if (pcMetrics_.hasChanged(line.id)) {
+            addDamage(damage, {static_cast<uint16_t>(dimensions_.x + 2),
+                               static_cast<uint16_t>(dimensions_.y + line.y + 2),
+                               static_cast<uint16_t>(kHostLabelX - 2), kTextLineHeight});
+        }
+    }
+    if (threadsWidget_) {
+        threadsWidget_->collectDamage(damage);
+    }
+}
+
+void PcMetricsWidget::loadSample(bool forceRedraw) {
+    if (hostChanged_) {
+        lastDrawnGeneration_ = 0;
+    }
+    lastGeneration_ = hosts_.getSnapshot(host_).read(pcMetrics_);
+    // The change mask is relative to the previous generation only, so anything not
+    // drawn in between (skipped or unavailable samples) leaves the screen stale
+    if (forceRedraw || lastGeneration_ != lastDrawnGeneration_ + 1) {
+        pcMetrics_.markAllChanged();
+    }
+    labelDirty_ = labelDirty_ || forceRedraw || hostChanged_ ||
+                  (pcMetrics_.changed_fields & FIELD_AVAILABILITY);
+    hostChanged_ = false;
+    samplePending_ = true;
+}
+
 bool PcMetricsWidget::needsUpdate() const {
-    if (!isInitialized_ || !pcMetrics_.is_available ||
-        !(pcMetrics_.last_update_timestamp > lastUpdateTimestamp_)) {
+    if (!isInitialized_) {
         return false;
     }
-    return true;
+    return hostChanged_ || hosts_.getSnapshot(host_).getGeneration() != lastGeneration_;
+}
+
+uint32_t PcMetricsWidget::msUntilUpdate() const {
+    return needsUpdate() ? 0 : UINT32_MAX;  // Publishing a sample wakes the screen
 }
 
 bool PcMetricsWidget::handleTouch(uint16_t x, uint16_t y) {
     if (threadsWidget_ && threadsWidget_->handleTouch(x, y)) {
         return true;
     }
-    return false;  // No touch interaction
+
+    if (hosts_.count() < 2) {
+        return false;
+    }
+
+    unsigned long now = millis();
+    if (now - lastTouchTime_ < config_.getUiTouchDebounceIntervalMs()) {
+        return false;
+    }
+    lastTouchTime_ = now;
+
+    host_ = (host_ + 1) % hosts_.count();
+    hostChanged_ = true;
+    return true;
+}
+
+void PcMetricsWidget::drawHostLabel() {
+    if (hosts_.count() < 2) {
+        return;
+    }
+
+    String label = hosts_.getName(host_);
+    if (!pcMetrics_.is_available) {
+        label += " (off)";
+    }
+
+    lcd_->fillRect(dimensions_.x + kHostLabelX, dimensions_.y, kHostLabelWidth, kHostLabelHeight,
+                   TFT_BLACK);
+    lcd_->setTextColor(pcMetrics_.is_available ? TFT_LIGHTGREY : TFT_DARKGREY, TFT_BLACK);
+    lcd_->setTextSize(1);
+    lcd_->setTextDatum(TL_DATUM);
+    lcd_->drawString(label.c_str(), dimensions_.x + kHostLabelX, dimensions_.y + 6);
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 #include <string>
 
-#include "services/pcMetrics/PcMetrics.h"
+#include "services/pcMetrics/PcMetricsHosts.h"
 #include "SingleValueWidget.h"
 #include "ui/DisplayContext.h"
 #include "ui/widgets/ThreadsWidget.h"
@@ -13,22 +13,43 @@
 class PcMetricsWidget : public Widget {
  public:
     PcMetricsWidget(DisplayContext& context, const Dimensions& dims, uint32_t updateIntervalMs,
-                    PcMetrics& pcMetrics, AppConfigInterface& config);
+                    PcMetricsHosts& hosts, AppConfigInterface& config);
 
     void drawStatic() override;
     void draw(bool forceRedraw = false) override;
     bool handleTouch(uint16_t x, uint16_t y) override;
     bool needsUpdate() const override;
+    uint32_t msUntilUpdate() const override;
+    void collectDamage(DamageRegion& damage) override;
+    void setSurface(lgfx::LovyanGFX* surface, int16_t originX, int16_t originY) override;
 
  private:
     DisplayContext& context_;
-    PcMetrics& pcMetrics_;
+    PcMetricsHosts& hosts_;
     AppConfigInterface& config_;
 
-    unsigned long lastUpdateTimestamp_ = 0;
+    // Host being shown, a tap switches to the next one
+    uint8_t host_ = 0;
+    bool hostChanged_ = true;
+    unsigned long lastTouchTime_ = 0;
+
+    // Local copy taken from the snapshot at the start of each draw
+    PcMetrics pcMetrics_;
+    uint32_t lastGeneration_ = 0;       // Last generation read from the snapshot
+    uint32_t lastDrawnGeneration_ = 0;  // Last generation actually drawn
+    bool samplePending_ = false;        // Read by collectDamage(), not drawn yet
+    bool labelDirty_ = false;
+
+    // A child widget showing one sensor, redrawn when that sensor changes
+    struct ValueBinding {
+        SensorId id;
+        std::unique_ptr<SingleValueWidget> widget;
+    };
 
     std::unique_ptr<ThreadsWidget> threadsWidget_;
-    std::unique_ptr<SingleValueWidget> cpuLoadWidget_;
-    std::unique_ptr<SingleValueWidget> gpu3dWidget_;
-    std::unique_ptr<SingleValueWidget> gpuComputeWidget_;
+    std::vector<ValueBinding> valueWidgets_;
+
+    void loadSample(bool forceRedraw);
+    void addSampleDamage(DamageRegion& damage);
+    void drawHostLabel();
 };
\ No newline at end of file
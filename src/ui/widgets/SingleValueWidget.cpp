@@ -1,11 +1,18 @@
 #include "SingleValueWidget.h"
 
+#include "ui/DamageRegion.h"
+
 SingleValueWidget::SingleValueWidget(DisplayContext& context, const Dimensions& dims,
                                      uint32_t updateIntervalMs)
     : Widget(dims, updateIntervalMs), context_(context) {
     updateDimensions();
 }
 
+void SingleValueWidget::setSurface(lgfx::LovyanGFX* surface, int16_t originX, int16_t originY) {
+    Widget::setSurface(surface, originX, originY);
+    dimensionsDirty_ = true;
+}
+
 void SingleValueWidget::drawStatic() {
     if (!isInitialized_ || !lcd_)
         return;
@@ -41,7 +48,7 @@ void SingleValueWidget::draw(bool forceRedraw) {
     if (!isInitialized_ || !lcd_)
         return;
 
-    if (forceRedraw || needsUpdate()) {
+    if (forceRedraw || valueDirty_ || needsUpdate()) {
         if (dimensionsDirty_) {
             updateDimensions();
         }
@@ -49,10 +56,22 @@ void SingleValueWidget::draw(bool forceRedraw) {
             updateTextSize();
         }
         drawValue();
+        valueDirty_ = false;
         lastUpdateTimeMs_ = millis();
     }
 }
 
+void SingleValueWidget::collectDamage(DamageRegion& damage) {
+    if (!isInitialized_ || !(valueDirty_ || needsUpdate())) {
+        return;
+    }
+    if (dimensionsDirty_) {
+        updateDimensions();
+    }
+    addDamage(damage, {static_cast<uint16_t>(valueX_), static_cast<uint16_t>(dimensions_.y + 1),
+                       valueWidth_, static_cast<uint16_t>(dimensions_.height - 2)});
+}
+
 void SingleValueWidget::drawValue() {
     uint16_t bgColor = getBackgroundColor();
 
@@ -62,6 +81,18 @@ void SingleValueWidget::drawValue() {
 
     // Prepare value text
     String valueText = String(value_) + unit_;
+    int16_t centerX = valueX_ + valueWidth_ / 2;
+    int16_t centerY = dimensions_.y + dimensions_.height / 2;
+
+    // Blit cached glyphs, the font engine only gets characters the atlas lacks
+    GlyphAtlas& glyphs = context_.getGlyphs();
+    int32_t textWidth = glyphs.textWidth(valueText.c_str(), optimalTextSize_);
+    if (textWidth >= 0) {
+        glyphs.drawString(*lcd_, valueText.c_str(), centerX - textWidth / 2,
+                          centerY - glyphs.fontHeight(optimalTextSize_) / 2, optimalTextSize_,
+                          TFT_WHITE, bgColor);
+        return;
+    }
 
     // Set text properties
     lcd_->setTextColor(TFT_WHITE, bgColor);
@@ -69,8 +100,6 @@ void SingleValueWidget::drawValue() {
     lcd_->setTextSize(optimalTextSize_);
 
     // Draw the text centered in the value area
-    int16_t centerX = valueX_ + valueWidth_ / 2;
-    int16_t centerY = dimensions_.y + dimensions_.height / 2;
     lcd_->drawString(valueText, centerX, centerY);
 }
 
@@ -86,16 +115,24 @@ void SingleValueWidget::updateTextSize() {
         return;
 
     String valueText = String(value_) + unit_;
-    optimalTextSize_ = 1;
-    lcd_->setTextSize(optimalTextSize_);
-    int16_t textWidth = lcd_->textWidth(valueText);
+    GlyphAtlas& glyphs = context_.getGlyphs();
+
+    // Sizes are measured from the atlas' advance widths, the font engine only for other text
+    auto fits = [&](uint8_t textSize) {
+        int32_t textWidth = glyphs.textWidth(valueText.c_str(), textSize);
+        int32_t fontHeight = glyphs.fontHeight(textSize);
+        if (textWidth < 0 || fontHeight < 0) {
+            lcd_->setTextSize(textSize);
+            textWidth = lcd_->textWidth(valueText);
+            fontHeight = lcd_->fontHeight();
+        }
+        return textWidth < (valueWidth_ - 10) && fontHeight < (dimensions_.height - 10);
+    };
 
     // Increase text size if it fits
-    while (optimalTextSize_ < 4 && textWidth < (valueWidth_ - 10) &&
-           lcd_->fontHeight() < (dimensions_.height - 10)) {
+    optimalTextSize_ = 1;
+    while (optimalTextSize_ < 4 && fits(optimalTextSize_)) {
         optimalTextSize_++;
-        lcd_->setTextSize(optimalTextSize_);
-        textWidth = lcd_->textWidth(valueText);
     }
 
     textSizeDirty_ = false;
@@ -120,7 +157,7 @@ void SingleValueWidget::setValue(int value) {
     if (value_ != value) {
         value_ = value;
         textSizeDirty_ = true;  // Value changed, text size might need update
-        draw();
+        valueDirty_ = true;
     }
 }
 
@@ -128,7 +165,7 @@ void SingleValueWidget::setUnit(const String& unit) {
     if (unit_ != unit) {
         unit_ = unit;
         textSizeDirty_ = true;  // Unit changed, text size might need update
-        draw();
+        valueDirty_ = true;
     }
 }
 
@@ -136,7 +173,7 @@ void SingleValueWidget::setRange(int minValue, int maxValue) {
     if (minValue_ != minValue || maxValue_ != maxValue) {
         minValue_ = minValue;
         maxValue_ = maxValue;
-        draw();
+        valueDirty_ = true;
     }
 }
 
@@ -145,7 +182,7 @@ void SingleValueWidget::setColorThresholds(float greenThreshold, float yellowThr
     greenThreshold_ = greenThreshold;
     yellowThreshold_ = yellowThreshold;
     redThreshold_ = redThreshold;
-    draw();
+    valueDirty_ = true;
 }
 
 void SingleValueWidget::setLabel(const String& label) {
@@ -9,7 +9,10 @@ class SingleValueWidget : public Widget {
     void drawStatic() override;
     void draw(bool forceRedraw = false) override;
     bool handleTouch(uint16_t x, uint16_t y) override;
+    void collectDamage(DamageRegion& damage) override;
+    void setSurface(lgfx::LovyanGFX* surface, int16_t originX, int16_t originY) override;
 
+    // Setters only mark the value for the next draw
     void setValue(int value);
     void setUnit(const String& unit);
     void setRange(int minValue, int maxValue);
@@ -38,6 +41,7 @@ class SingleValueWidget : public Widget {
     uint8_t optimalTextSize_ = 1;
     bool dimensionsDirty_ = true;
     bool textSizeDirty_ = true;
+    bool valueDirty_ = true;  // Value, unit or colours changed since last drawn
 
     uint16_t getBackgroundColor() const;
     void drawValue();
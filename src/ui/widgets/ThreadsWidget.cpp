@@ -1,14 +1,15 @@
 #include "ThreadsWidget.h"
 
+#include <algorithm>
+
+#include "ui/DamageRegion.h"
+
 ThreadsWidget::ThreadsWidget(DisplayContext& context, const Dimensions& dims,
-                             uint32_t updateIntervalMs, PcMetrics& pcMetrics,
-                             AppConfigInterface& config)
+                             uint32_t updateIntervalMs, PcMetrics& pcMetrics)
     : Widget(dims, updateIntervalMs),
       context_(context),
       pcMetrics_(pcMetrics),
-      barWidth_(dims.width / config_.getPcMetricsCores()),
-      config_(config),
-      previousBarHeights_(config_.getPcMetricsCores(), 0) {}
+      previousBarHeights_(PcMetrics::MAX_THREADS, 0) {}
 
 void ThreadsWidget::drawStatic() {
     if (!isInitialized_ || !lcd_)
@@ -23,15 +24,34 @@ void ThreadsWidget::draw(bool forceRedraw) {
 
     if (needsRedraw && pcMetrics_.is_available) {
         drawBars(forceRedraw);
-        lastUpdateTimestamp_ = pcMetrics_.last_update_timestamp;
         lastUpdateTimeMs_ = millis();
     }
 }
 
+void ThreadsWidget::layoutBars(uint8_t threadCount) {
+    threadCount_ = min(threadCount, PcMetrics::MAX_THREADS);
+    barWidth_ = threadCount_ > 0 ? dimensions_.width / threadCount_ : 0;
+
+    // Old bars no longer line up with the new layout
+    lcd_->fillRect(dimensions_.x, dimensions_.y, dimensions_.width, dimensions_.height,
+                   TFT_BLACK);
+    std::fill(previousBarHeights_.begin(), previousBarHeights_.end(), 0);
+}
+
 void ThreadsWidget::drawBars(bool forceRedraw) {
     const uint16_t maxBarHeight = dimensions_.height;
 
-    for (int i = 0; i < config_.getPcMetricsCores(); ++i) {
+    if (pcMetrics_.cpu_thread_count != threadCount_) {
+        layoutBars(pcMetrics_.cpu_thread_count);
+        forceRedraw = true;
+    }
+
+    for (uint8_t i = 0; i < threadCount_; ++i) {
+        // Only threads flagged in the snapshot's change mask can have moved
+        if (!forceRedraw && !(pcMetrics_.changed_threads & (1ull << i))) {
+            continue;
+        }
+
         uint16_t newHeight =
             static_cast<uint16_t>(pcMetrics_.cpu_thread_load[i] * maxBarHeight / 100);
         ;
@@ -64,12 +84,29 @@ void ThreadsWidget::drawBars(bool forceRedraw) {
         }
     }
 }
+
+void ThreadsWidget::collectDamage(DamageRegion& damage) {
+    if (!needsUpdate()) {
+        return;
+    }
+    if (pcMetrics_.cpu_thread_count != threadCount_) {
+        addDamage(damage, dimensions_);  // Relayout clears everything
+        return;
+    }
+    for (uint8_t i = 0; i < threadCount_; ++i) {
+        if (pcMetrics_.changed_threads & (1ull << i)) {
+            // Whole column with its 1 px gap, so neighbouring bars merge into one rectangle
+            uint16_t x = dimensions_.x + i * barWidth_;
+            addDamage(damage, {x, dimensions_.y, barWidth_, dimensions_.height});
+        }
+    }
+}
+
 bool ThreadsWidget::needsUpdate() const {
-    if (!isInitialized_ || !pcMetrics_.is_available ||
-        !(pcMetrics_.last_update_timestamp > lastUpdateTimestamp_)) {
+    if (!isInitialized_ || !pcMetrics_.is_available) {
         return false;
     }
-    return true;
+    return (pcMetrics_.changed_fields & FIELD_CPU_THREAD_LOAD) != 0;
 }
 
 bool ThreadsWidget::handleTouch(uint16_t x, uint16_t y) {
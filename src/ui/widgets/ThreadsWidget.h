@@ -1,6 +1,5 @@
 #pragma once
 
-#include "config/AppConfigInterface.h"
 #include "services/pcMetrics/PcMetrics.h"
 #include "ui/DisplayContext.h"
 #include "ui/widgets/Widget.h"
@@ -8,20 +7,23 @@
 class ThreadsWidget : public Widget {
  public:
     ThreadsWidget(DisplayContext& context, const Dimensions& dims, uint32_t updateIntervalMs,
-                  PcMetrics& pcMetrics, AppConfigInterface& config);
+                  PcMetrics& pcMetrics);
 
     void drawStatic() override;
     void draw(bool forceRedraw = false) override;
     bool handleTouch(uint16_t x, uint16_t y) override;
     bool needsUpdate() const override;
+    void collectDamage(DamageRegion& damage) override;
 
  private:
     DisplayContext& context_;
     PcMetrics& pcMetrics_;
-    AppConfigInterface& config_;
 
-    uint16_t barWidth_;
-    std::vector<uint16_t> previousBarHeights_;
-    unsigned long lastUpdateTimestamp_ = 0;
+    // Bars are laid out for the thread count of the sample last drawn
+    uint8_t threadCount_ = 0;
+    uint16_t barWidth_ = 0;
+    std::vector<uint16_t> previousBarHeights_;  // Sized for PcMetrics::MAX_THREADS
+
+    void layoutBars(uint8_t threadCount);
     void drawBars(bool forceRedraw);
 };
\ No newline at end of file
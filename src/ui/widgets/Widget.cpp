@@ -1,5 +1,7 @@
 #include "Widget.h"
 
+#include "ui/DamageRegion.h"
+
 Widget::Widget(const Dimensions& dims, uint32_t updateIntervalMs)
     : dimensions_(dims), updateIntervalMs_(updateIntervalMs), lastUpdateTimeMs_(0) {}
 
@@ -12,7 +14,7 @@ void Widget::initialize(DisplayContext& context) {
     //     Serial.println("Widget initialization failed - null logger");
     //     return;
     // }
-    lcd_ = &context.getDisplay();
+    lcd_ = surface_ ? surface_ : &context.getDisplay();
     logger_ = &context.getLogger();
     lastUpdateTimeMs_ = millis();
     isInitialized_ = true;
@@ -32,6 +34,7 @@ void Widget::cleanUp() {
     }
     isInitialized_ = false;
     isStaticDrawn_ = false;
+    setSurface(nullptr, 0, 0);  // The manager frees the sprite
     lcd_ = nullptr;
     logger_ = nullptr;
 }
@@ -47,6 +50,36 @@ bool Widget::needsUpdate() const {
     return (millis() - lastUpdateTimeMs_ >= updateIntervalMs_);
 }
 
+uint32_t Widget::msUntilUpdate() const {
+    if (!isInitialized_ || updateIntervalMs_ == 0) {
+        return UINT32_MAX;
+    }
+    uint32_t elapsed = millis() - lastUpdateTimeMs_;
+    return elapsed >= updateIntervalMs_ ? 0 : updateIntervalMs_ - elapsed;
+}
+
+void Widget::collectDamage(DamageRegion& damage) {
+    if (isInitialized_ && needsUpdate()) {
+        addDamage(damage, dimensions_);
+    }
+}
+
 WidgetInterface::Dimensions Widget::getDimensions() const {
-    return dimensions_;
+    return {static_cast<uint16_t>(dimensions_.x + originX_),
+            static_cast<uint16_t>(dimensions_.y + originY_), dimensions_.width,
+            dimensions_.height};
+}
+
+void Widget::setSurface(lgfx::LovyanGFX* surface, int16_t originX, int16_t originY) {
+    Dimensions screen = getDimensions();
+    surface_ = surface;
+    originX_ = surface ? originX : 0;
+    originY_ = surface ? originY : 0;
+    dimensions_.x = screen.x - originX_;
+    dimensions_.y = screen.y - originY_;
+}
+
+void Widget::addDamage(DamageRegion& damage, const Dimensions& rect) const {
+    damage.add({static_cast<uint16_t>(rect.x + originX_),
+                static_cast<uint16_t>(rect.y + originY_), rect.width, rect.height});
 }
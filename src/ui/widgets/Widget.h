@@ -15,12 +15,23 @@ class Widget : public WidgetInterface {
     void cleanUp() override;
     void setUpdateInterval(uint32_t intervalMs) override;
     bool needsUpdate() const override;
+    uint32_t msUntilUpdate() const override;
+    void collectDamage(DamageRegion& damage) override;
     Dimensions getDimensions() const override;
+    void setSurface(lgfx::LovyanGFX* surface, int16_t originX, int16_t originY) override;
 
  protected:
-    LGFX* lcd_ = nullptr;
+    /**
+     * Adds rect, given in drawing coordinates like dimensions_, as screen damage
+     */
+    void addDamage(DamageRegion& damage, const Dimensions& rect) const;
+
+    lgfx::LovyanGFX* lcd_ = nullptr;  // The panel, or the surface set for off-screen drawing
+    lgfx::LovyanGFX* surface_ = nullptr;
     LoggerInterface* logger_ = nullptr;
-    Dimensions dimensions_;
+    Dimensions dimensions_;  // In drawing coordinates, relative to the surface if there is one
+    int16_t originX_ = 0;    // Screen position of the drawing coordinates' origin
+    int16_t originY_ = 0;
     uint32_t updateIntervalMs_;
     uint32_t lastUpdateTimeMs_ = 0;
     bool isInitialized_ = false;
@@ -3,6 +3,8 @@
 #include "ui/DisplayContext.h"
 #include "ui/screens/ScreenInterface.h"
 
+class DamageRegion;
+
 class WidgetInterface {
  public:
     struct Dimensions {
@@ -23,10 +25,22 @@ class WidgetInterface {
     // Update control
     virtual void setUpdateInterval(uint32_t intervalMs) = 0;
     virtual bool needsUpdate() const = 0;
+    // Time until needsUpdate() turns true by itself, UINT32_MAX when only a wakeup event
+    // (new metrics, a touch) can make it. The screen task sleeps until the earliest.
+    virtual uint32_t msUntilUpdate() const = 0;
+
+    // Damage tracking: called once per frame before draw(), adds the areas draw() will
+    // change. The manager then draws the widget clipped to them, so whatever draw() paints
+    // must be decided here (state read after this call may not make it to the screen).
+    virtual void collectDamage(DamageRegion& damage) = 0;
 
     // Touch handling
     virtual bool handleTouch(uint16_t x, uint16_t y) = 0;
 
-    // Immutable dimensions access
+    // Immutable dimensions access (screen coordinates)
     virtual Dimensions getDimensions() const = 0;
+
+    // Off-screen drawing: set before initialize(), draw calls then go to surface, whose top
+    // left corner is at (originX, originY) on the screen. nullptr draws on the panel.
+    virtual void setSurface(lgfx::LovyanGFX* surface, int16_t originX, int16_t originY) = 0;
 };
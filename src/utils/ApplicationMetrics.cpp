@@ -1,30 +1,322 @@
 #include "ApplicationMetrics.h"
 
+#include <algorithm>
+
+namespace {
+// Holds the PC metrics mutex for the rest of the scope
+class PcMetricsLock {
+ public:
+    explicit PcMetricsLock(SemaphoreHandle_t mutex) : mutex_(mutex) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+    }
+    ~PcMetricsLock() { xSemaphoreGive(mutex_); }
+
+    PcMetricsLock(const PcMetricsLock&) = delete;
+    PcMetricsLock& operator=(const PcMetricsLock&) = delete;
+
+ private:
+    SemaphoreHandle_t mutex_;
+};
+}  // namespace
+
 ApplicationMetrics::ApplicationMetrics(AppConfigInterface& config)
-    : pcMetricsJsonParseTime_(0),
+    : config_(config),
+      pcMetricsMutex_(xSemaphoreCreateMutex()),
+      pcMetricsJsonParseTime_(0),
+      pcMetricsPayloadSize_{0, 0},
+      pcMetricsPayloadParseTime_{0, 0},
+      pcMetricsPeakHeapStreamed_(0),
+      pcMetricsPeakHeapBuffered_(0),
+      pcMetricsJsonArenaCount_(0),
+      pcMetricsJsonArenaBytes_(0),
+      pcMetricsJsonArenaHighWater_(0),
+      pcMetricsJsonArenaOverflow_(0),
+      pcMetricsJsonArenaSpills_(0),
+      pcMetricsRequestCount_{0, 0},
+      pcMetricsRequestTimeSum_{0, 0},
+      pcMetricsReconnectCount_(0),
+      pcMetricsFetchHistograms_(),
+      pcMetricsFetchCancelled_(0),
+      pcMetricsHostLocked_(false),
+      pcMetricsHostPeriod_(0),
+      pcMetricsHostPhase_(0),
+      pcMetricsDataAge_(0),
+      pcMetricsSampleLatency_(0),
+      pcMetricsDroppedSamples_(0),
+      pcMetricsHostStats_(config.getPcMetricsMaxHosts()),
+      pcMetricsPushCount_(0),
+      pcMetricsPushBytes_(0),
+      screenDrawTimes_(),
       screenDrawCapacity_(static_cast<size_t>(config_.getMetricsMaxScreenDrawTimes())),
       screenDrawIndex_(0),
       screenDrawCount_(0),
-      screenDrawTimes_(),
-      config_(config) {
+      screenWakeupsNotified_(0),
+      screenWakeupsTimed_(0),
+      screenDamageFrames_(0),
+      screenReportedPixels_(0),
+      screenFlushedPixels_(0),
+      screenLastFlushedPixels_(0),
+      screenMaxFlushedPixels_(0),
+      screenSpriteCount_(0),
+      screenSpriteBytes_(0),
+      screenDirectWidgets_(0) {
     // Initialize vector with zeros sized from config
     if (screenDrawCapacity_ == 0) {
         screenDrawCapacity_ = 1;  // avoid zero-size vector if config returns 0
     }
-    screenDrawTimes_.assign(screenDrawCapacity_, 0);
+    screenDrawTimes_.assign(screenDrawCapacity_, {0, 0, 0});
+}
+
+ApplicationMetrics::~ApplicationMetrics() {
+    vSemaphoreDelete(pcMetricsMutex_);
 }
 
 void ApplicationMetrics::setPcMetricsJsonParseTime(uint32_t timeMs) {
+    PcMetricsLock lock(pcMetricsMutex_);
     pcMetricsJsonParseTime_ = timeMs;
 }
 
 uint32_t ApplicationMetrics::getPcMetricsJsonParseTime() const {
+    PcMetricsLock lock(pcMetricsMutex_);
     return pcMetricsJsonParseTime_;
 }
 
-void ApplicationMetrics::addScreenDrawTime(uint32_t timeMs) {
+void ApplicationMetrics::setPcMetricsPayload(bool binary, uint32_t bytes,
+                                             uint32_t parseTimeMs) {
+    PcMetricsLock lock(pcMetricsMutex_);
+    size_t format = binary ? 1 : 0;
+    pcMetricsPayloadSize_[format] = bytes;
+    pcMetricsPayloadParseTime_[format] = parseTimeMs;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsPayloadSize(bool binary) const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsPayloadSize_[binary ? 1 : 0];
+}
+
+uint32_t ApplicationMetrics::getPcMetricsPayloadParseTime(bool binary) const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsPayloadParseTime_[binary ? 1 : 0];
+}
+
+void ApplicationMetrics::setPcMetricsPeakHeap(bool streamed, uint32_t bytes) {
+    PcMetricsLock lock(pcMetricsMutex_);
+    if (streamed) {
+        pcMetricsPeakHeapStreamed_ = bytes;
+    } else {
+        pcMetricsPeakHeapBuffered_ = bytes;
+    }
+}
+
+uint32_t ApplicationMetrics::getPcMetricsPeakHeapStreamed() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsPeakHeapStreamed_;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsPeakHeapBuffered() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsPeakHeapBuffered_;
+}
+
+void ApplicationMetrics::addPcMetricsJsonArena(uint32_t capacity) {
+    PcMetricsLock lock(pcMetricsMutex_);
+    pcMetricsJsonArenaCount_++;
+    pcMetricsJsonArenaBytes_ += capacity;
+}
+
+void ApplicationMetrics::addPcMetricsJsonArenaUse(uint32_t bytes, uint32_t overflowBytes) {
+    PcMetricsLock lock(pcMetricsMutex_);
+    pcMetricsJsonArenaHighWater_ = std::max(pcMetricsJsonArenaHighWater_, bytes);
+    pcMetricsJsonArenaOverflow_ = std::max(pcMetricsJsonArenaOverflow_, overflowBytes);
+    if (overflowBytes > 0) {
+        pcMetricsJsonArenaSpills_++;
+    }
+}
+
+uint32_t ApplicationMetrics::getPcMetricsJsonArenaCount() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsJsonArenaCount_;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsJsonArenaBytes() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsJsonArenaBytes_;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsJsonArenaHighWater() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsJsonArenaHighWater_;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsJsonArenaOverflowHighWater() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsJsonArenaOverflow_;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsJsonArenaSpillCount() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsJsonArenaSpills_;
+}
+
+void ApplicationMetrics::addPcMetricsRequest(uint32_t timeMs, bool reusedConnection,
+                                             bool reconnected) {
+    PcMetricsLock lock(pcMetricsMutex_);
+    size_t kind = reusedConnection ? 1 : 0;
+    pcMetricsRequestCount_[kind]++;
+    pcMetricsRequestTimeSum_[kind] += timeMs;
+    if (reconnected) {
+        pcMetricsReconnectCount_++;
+    }
+}
+
+void ApplicationMetrics::addPcMetricsFetchPhase(FetchPhase phase, uint32_t timeMs) {
+    PcMetricsLock lock(pcMetricsMutex_);
+    size_t bucket = std::lower_bound(FETCH_BUCKET_BOUNDS_MS.begin(), FETCH_BUCKET_BOUNDS_MS.end(),
+                                     timeMs) -
+                    FETCH_BUCKET_BOUNDS_MS.begin();
+    pcMetricsFetchHistograms_[static_cast<size_t>(phase)][bucket]++;
+}
+
+void ApplicationMetrics::addPcMetricsFetchCancelled() {
+    PcMetricsLock lock(pcMetricsMutex_);
+    pcMetricsFetchCancelled_++;
+}
+
+ApplicationMetrics::FetchHistogram ApplicationMetrics::getPcMetricsFetchHistogram(
+    FetchPhase phase) const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsFetchHistograms_[static_cast<size_t>(phase)];
+}
+
+uint32_t ApplicationMetrics::getPcMetricsFetchCancelledCount() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsFetchCancelled_;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsRequestCount(bool reusedConnection) const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsRequestCount_[reusedConnection ? 1 : 0];
+}
+
+float ApplicationMetrics::getAveragePcMetricsRequestTime(bool reusedConnection) const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    size_t kind = reusedConnection ? 1 : 0;
+    if (pcMetricsRequestCount_[kind] == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(pcMetricsRequestTimeSum_[kind]) /
+           static_cast<float>(pcMetricsRequestCount_[kind]);
+}
+
+uint32_t ApplicationMetrics::getPcMetricsReconnectCount() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsReconnectCount_;
+}
+
+void ApplicationMetrics::setPcMetricsHostTiming(bool locked, uint32_t periodMs, uint32_t phaseMs,
+                                                uint32_t dataAgeMs) {
+    PcMetricsLock lock(pcMetricsMutex_);
+    pcMetricsHostLocked_ = locked;
+    pcMetricsHostPeriod_ = periodMs;
+    pcMetricsHostPhase_ = phaseMs;
+    pcMetricsDataAge_ = dataAgeMs;
+}
+
+bool ApplicationMetrics::isPcMetricsHostLocked() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsHostLocked_;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsHostPeriod() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsHostPeriod_;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsHostPhase() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsHostPhase_;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsDataAge() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsDataAge_;
+}
+
+void ApplicationMetrics::setPcMetricsPipeline(uint32_t latencyMs, uint32_t droppedSamples) {
+    PcMetricsLock lock(pcMetricsMutex_);
+    pcMetricsSampleLatency_ = latencyMs;
+    pcMetricsDroppedSamples_ = droppedSamples;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsSampleLatency() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsSampleLatency_;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsDroppedSamples() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsDroppedSamples_;
+}
+
+void ApplicationMetrics::addPcMetricsHostPoll(uint8_t host, uint32_t fetchTimeMs, bool success) {
+    PcMetricsLock lock(pcMetricsMutex_);
+    if (host >= pcMetricsHostStats_.size()) {
+        return;
+    }
+    HostPollStats& stats = pcMetricsHostStats_[host];
+    stats.polls++;
+    if (success) {
+        stats.fetchTimeSum += fetchTimeMs;
+    } else {
+        stats.failures++;
+    }
+}
+
+uint32_t ApplicationMetrics::getPcMetricsHostPollCount(uint8_t host) const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return host < pcMetricsHostStats_.size() ? pcMetricsHostStats_[host].polls : 0;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsHostFailureCount(uint8_t host) const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return host < pcMetricsHostStats_.size() ? pcMetricsHostStats_[host].failures : 0;
+}
+
+float ApplicationMetrics::getAveragePcMetricsHostFetchTime(uint8_t host) const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    if (host >= pcMetricsHostStats_.size()) {
+        return 0.0f;
+    }
+    const HostPollStats& stats = pcMetricsHostStats_[host];
+    uint32_t successes = stats.polls - stats.failures;
+    if (successes == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(stats.fetchTimeSum) / successes;
+}
+
+void ApplicationMetrics::addPcMetricsPush(uint32_t bytes) {
+    PcMetricsLock lock(pcMetricsMutex_);
+    pcMetricsPushCount_++;
+    pcMetricsPushBytes_ += bytes;
+}
+
+uint32_t ApplicationMetrics::getPcMetricsPushCount() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    return pcMetricsPushCount_;
+}
+
+float ApplicationMetrics::getAveragePcMetricsPushSize() const {
+    PcMetricsLock lock(pcMetricsMutex_);
+    if (pcMetricsPushCount_ == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(pcMetricsPushBytes_) / pcMetricsPushCount_;
+}
+
+void ApplicationMetrics::addScreenDrawTime(uint32_t cpuUs, uint32_t busUs, uint32_t directUs) {
     // Store the new time at the current index
-    screenDrawTimes_[screenDrawIndex_] = timeMs;
+    screenDrawTimes_[screenDrawIndex_] = {cpuUs, busUs, directUs};
 
     // Advance the index (wrap around if at the end)
     screenDrawIndex_ = (screenDrawIndex_ + 1) % screenDrawCapacity_;
@@ -35,11 +327,12 @@ void ApplicationMetrics::addScreenDrawTime(uint32_t timeMs) {
     }
 }
 
-const std::vector<uint32_t>& ApplicationMetrics::getScreenDrawTimes() const {
+const std::vector<ApplicationMetrics::ScreenDrawTime>& ApplicationMetrics::getScreenDrawTimes()
+    const {
     return screenDrawTimes_;
 }
 
-float ApplicationMetrics::getAverageScreenDrawTime() const {
+float ApplicationMetrics::getAverageScreenCpuTime() const {
     if (screenDrawCount_ == 0) {
         return 0.0f;
     }
@@ -50,7 +343,37 @@ float ApplicationMetrics::getAverageScreenDrawTime() const {
         (screenDrawIndex_ + screenDrawCapacity_ - screenDrawCount_) % screenDrawCapacity_;
     for (size_t i = 0; i < screenDrawCount_; ++i) {
         size_t idx = (start + i) % screenDrawCapacity_;
-        sum += screenDrawTimes_[idx];
+        sum += screenDrawTimes_[idx].cpuUs;
+    }
+    return static_cast<float>(sum) / static_cast<float>(screenDrawCount_);
+}
+
+float ApplicationMetrics::getAverageScreenBusTime() const {
+    if (screenDrawCount_ == 0) {
+        return 0.0f;
+    }
+
+    uint64_t sum = 0;
+    size_t start =
+        (screenDrawIndex_ + screenDrawCapacity_ - screenDrawCount_) % screenDrawCapacity_;
+    for (size_t i = 0; i < screenDrawCount_; ++i) {
+        size_t idx = (start + i) % screenDrawCapacity_;
+        sum += screenDrawTimes_[idx].busUs;
+    }
+    return static_cast<float>(sum) / static_cast<float>(screenDrawCount_);
+}
+
+float ApplicationMetrics::getAverageScreenDirectTime() const {
+    if (screenDrawCount_ == 0) {
+        return 0.0f;
+    }
+
+    uint64_t sum = 0;
+    size_t start =
+        (screenDrawIndex_ + screenDrawCapacity_ - screenDrawCount_) % screenDrawCapacity_;
+    for (size_t i = 0; i < screenDrawCount_; ++i) {
+        size_t idx = (start + i) % screenDrawCapacity_;
+        sum += screenDrawTimes_[idx].directUs;
     }
     return static_cast<float>(sum) / static_cast<float>(screenDrawCount_);
 }
@@ -59,6 +382,74 @@ size_t ApplicationMetrics::getScreenDrawCount() const {
     return screenDrawCount_;
 }
 
+void ApplicationMetrics::addScreenWakeup(bool notified) {
+    if (notified) {
+        screenWakeupsNotified_++;
+    } else {
+        screenWakeupsTimed_++;
+    }
+}
+
+uint32_t ApplicationMetrics::getScreenWakeupsNotified() const {
+    return screenWakeupsNotified_;
+}
+
+uint32_t ApplicationMetrics::getScreenWakeupsTimed() const {
+    return screenWakeupsTimed_;
+}
+
+void ApplicationMetrics::addScreenDamage(uint32_t reportedPixels, uint32_t flushedPixels) {
+    screenDamageFrames_++;
+    screenReportedPixels_ += reportedPixels;
+    screenFlushedPixels_ += flushedPixels;
+    screenLastFlushedPixels_ = flushedPixels;
+    screenMaxFlushedPixels_ = std::max(screenMaxFlushedPixels_, flushedPixels);
+}
+
+uint32_t ApplicationMetrics::getScreenDamageFrameCount() const {
+    return screenDamageFrames_;
+}
+
+uint32_t ApplicationMetrics::getLastScreenFlushedPixels() const {
+    return screenLastFlushedPixels_;
+}
+
+uint32_t ApplicationMetrics::getMaxScreenFlushedPixels() const {
+    return screenMaxFlushedPixels_;
+}
+
+float ApplicationMetrics::getAverageScreenFlushedPixels() const {
+    if (screenDamageFrames_ == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(screenFlushedPixels_) / screenDamageFrames_;
+}
+
+float ApplicationMetrics::getAverageScreenReportedPixels() const {
+    if (screenDamageFrames_ == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(screenReportedPixels_) / screenDamageFrames_;
+}
+
+void ApplicationMetrics::setScreenSprites(uint32_t count, uint32_t bytes, uint32_t directCount) {
+    screenSpriteCount_ = count;
+    screenSpriteBytes_ = bytes;
+    screenDirectWidgets_ = directCount;
+}
+
+uint32_t ApplicationMetrics::getScreenSpriteCount() const {
+    return screenSpriteCount_;
+}
+
+uint32_t ApplicationMetrics::getScreenSpriteBytes() const {
+    return screenSpriteBytes_;
+}
+
+uint32_t ApplicationMetrics::getScreenDirectWidgetCount() const {
+    return screenDirectWidgets_;
+}
+
 String ApplicationMetrics::getFormattedUptime() const {
     char buffer[20];
     unsigned long uptimeMs = millis();
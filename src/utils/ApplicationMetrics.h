@@ -1,34 +1,178 @@
 #pragma once
 
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 #include <array>
 
 #include "config/AppConfigInterface.h"
 
+/**
+ * Phases of an LHM fetch, timed separately
+ */
+enum class FetchPhase : uint8_t { CONNECT, TTFB, TRANSFER, COUNT };
+
+constexpr size_t FETCH_PHASE_COUNT = static_cast<size_t>(FetchPhase::COUNT);
+
 class ApplicationMetrics {
  public:
+    // Upper bounds (ms) of the fetch phase histogram buckets, a last bucket takes the rest
+    static constexpr std::array<uint32_t, 8> FETCH_BUCKET_BOUNDS_MS = {10,  25,  50,   100,
+                                                                       250, 500, 1000, 2500};
+    static constexpr size_t FETCH_BUCKET_COUNT = FETCH_BUCKET_BOUNDS_MS.size() + 1;
+    using FetchHistogram = std::array<uint32_t, FETCH_BUCKET_COUNT>;
+
     ApplicationMetrics(AppConfigInterface& config);
+    ~ApplicationMetrics();
+
+    ApplicationMetrics(const ApplicationMetrics&) = delete;
+    ApplicationMetrics& operator=(const ApplicationMetrics&) = delete;
+
+    // PC metrics: written by the poll, parse and push tasks at once, serialized by a mutex
 
     // JSON parse time methods
     void setPcMetricsJsonParseTime(uint32_t timeMs);
     uint32_t getPcMetricsJsonParseTime() const;
 
-    // Screen draw time methods
-    void addScreenDrawTime(uint32_t timeMs);
-    const std::vector<uint32_t>& getScreenDrawTimes() const;
-    float getAverageScreenDrawTime() const;
+    // Latest payload size and parse time, per wire format (JSON or MessagePack)
+    void setPcMetricsPayload(bool binary, uint32_t bytes, uint32_t parseTimeMs);
+    uint32_t getPcMetricsPayloadSize(bool binary) const;
+    uint32_t getPcMetricsPayloadParseTime(bool binary) const;
+
+    // Peak heap taken by a single PC metrics fetch + parse, per fetch mode
+    void setPcMetricsPeakHeap(bool streamed, uint32_t bytes);
+    uint32_t getPcMetricsPeakHeapStreamed() const;
+    uint32_t getPcMetricsPeakHeapBuffered() const;
+
+    // JSON arenas of the PC metrics parsers (one per parser that got PSRAM), and the
+    // most a single poll used in total and beyond its arena
+    void addPcMetricsJsonArena(uint32_t capacity);
+    void addPcMetricsJsonArenaUse(uint32_t bytes, uint32_t overflowBytes);
+    uint32_t getPcMetricsJsonArenaCount() const;
+    uint32_t getPcMetricsJsonArenaBytes() const;
+    uint32_t getPcMetricsJsonArenaHighWater() const;
+    uint32_t getPcMetricsJsonArenaOverflowHighWater() const;
+    uint32_t getPcMetricsJsonArenaSpillCount() const;
+
+    // LHM request times (connect + time to headers), split by connection reuse
+    void addPcMetricsRequest(uint32_t timeMs, bool reusedConnection, bool reconnected);
+    uint32_t getPcMetricsRequestCount(bool reusedConnection) const;
+    float getAveragePcMetricsRequestTime(bool reusedConnection) const;
+    uint32_t getPcMetricsReconnectCount() const;
+
+    // LHM fetch phase times, and fetches cancelled when their budget ran out
+    void addPcMetricsFetchPhase(FetchPhase phase, uint32_t timeMs);
+    void addPcMetricsFetchCancelled();
+    FetchHistogram getPcMetricsFetchHistogram(FetchPhase phase) const;
+    uint32_t getPcMetricsFetchCancelledCount() const;
+
+    // LHM host refresh estimate from the poll scheduler
+    void setPcMetricsHostTiming(bool locked, uint32_t periodMs, uint32_t phaseMs,
+                                uint32_t dataAgeMs);
+    bool isPcMetricsHostLocked() const;
+    uint32_t getPcMetricsHostPeriod() const;
+    uint32_t getPcMetricsHostPhase() const;
+    uint32_t getPcMetricsDataAge() const;
+
+    // Fetch/parse pipeline: request start to publish, and responses dropped unparsed
+    void setPcMetricsPipeline(uint32_t latencyMs, uint32_t droppedSamples);
+    uint32_t getPcMetricsSampleLatency() const;
+    uint32_t getPcMetricsDroppedSamples() const;
+
+    // Per LHM host polls (index as in PcMetricsHosts): fetch time and failures
+    void addPcMetricsHostPoll(uint8_t host, uint32_t fetchTimeMs, bool success);
+    uint32_t getPcMetricsHostPollCount(uint8_t host) const;
+    uint32_t getPcMetricsHostFailureCount(uint8_t host) const;
+    float getAveragePcMetricsHostFetchTime(uint8_t host) const;
+
+    // Updates pushed by the PC instead of polled
+    void addPcMetricsPush(uint32_t bytes);
+    uint32_t getPcMetricsPushCount() const;
+    float getAveragePcMetricsPushSize() const;
+
+    // Screen draw times (us): composing on the CPU, blocked on the panel bus, and
+    // widgets without a sprite drawing on the panel directly, CPU and bus not split
+    struct ScreenDrawTime {
+        uint32_t cpuUs;
+        uint32_t busUs;
+        uint32_t directUs;
+    };
+    void addScreenDrawTime(uint32_t cpuUs, uint32_t busUs, uint32_t directUs);
+    const std::vector<ScreenDrawTime>& getScreenDrawTimes() const;
+    float getAverageScreenCpuTime() const;
+    float getAverageScreenBusTime() const;
+    float getAverageScreenDirectTime() const;
     size_t getScreenDrawCount() const;
 
+    // Screen task wakeups: notified (new sample, touch, screen request) or a deadline passed
+    void addScreenWakeup(bool notified);
+    uint32_t getScreenWakeupsNotified() const;
+    uint32_t getScreenWakeupsTimed() const;
+
+    // Damaged pixels per drawn frame: as reported by the widgets and after merging
+    void addScreenDamage(uint32_t reportedPixels, uint32_t flushedPixels);
+    uint32_t getScreenDamageFrameCount() const;
+    uint32_t getLastScreenFlushedPixels() const;
+    uint32_t getMaxScreenFlushedPixels() const;
+    float getAverageScreenFlushedPixels() const;
+    float getAverageScreenReportedPixels() const;
+
+    // Widgets of the current screen drawing into PSRAM sprites, and those drawing direct
+    void setScreenSprites(uint32_t count, uint32_t bytes, uint32_t directCount);
+    uint32_t getScreenSpriteCount() const;
+    uint32_t getScreenSpriteBytes() const;
+    uint32_t getScreenDirectWidgetCount() const;
+
     // Uptime method
     String getFormattedUptime() const;
 
  private:
     AppConfigInterface& config_;
 
+    SemaphoreHandle_t pcMetricsMutex_;       // Guards every pcMetrics member
     uint32_t pcMetricsJsonParseTime_;        // Latest JSON parse time for PC metrics
-    std::vector<uint32_t> screenDrawTimes_;  // Circular buffer for screen draw times
+    uint32_t pcMetricsPayloadSize_[2];       // Latest body size as [JSON, MessagePack]
+    uint32_t pcMetricsPayloadParseTime_[2];  // Latest parse time as [JSON, MessagePack]
+    uint32_t pcMetricsPeakHeapStreamed_;     // Latest per-poll peak heap, streamed fetch
+    uint32_t pcMetricsPeakHeapBuffered_;     // Latest per-poll peak heap, buffered fetch
+    uint32_t pcMetricsJsonArenaCount_;       // Parsers with a PSRAM arena
+    uint32_t pcMetricsJsonArenaBytes_;       // PSRAM taken by all of them
+    uint32_t pcMetricsJsonArenaHighWater_;   // Most bytes one document took
+    uint32_t pcMetricsJsonArenaOverflow_;    // Most of those that did not fit its arena
+    uint32_t pcMetricsJsonArenaSpills_;      // Polls that did not fit
+    uint32_t pcMetricsRequestCount_[2];      // Requests over [new, reused] connections
+    uint64_t pcMetricsRequestTimeSum_[2];    // Total request time over [new, reused]
+    uint32_t pcMetricsReconnectCount_;       // Kept-alive sockets found closed by the host
+    std::array<FetchHistogram, FETCH_PHASE_COUNT> pcMetricsFetchHistograms_;
+    uint32_t pcMetricsFetchCancelled_;       // Fetches stopped by their deadline
+    bool pcMetricsHostLocked_;               // Poll phase locked to the host refresh
+    uint32_t pcMetricsHostPeriod_;           // Estimated host refresh period
+    uint32_t pcMetricsHostPhase_;            // Estimated host update offset within the period
+    uint32_t pcMetricsDataAge_;              // Latest poll time minus estimated host update
+    uint32_t pcMetricsSampleLatency_;        // Latest request start to publish, pipelined
+    uint32_t pcMetricsDroppedSamples_;       // Responses replaced before the parser got them
+    struct HostPollStats {
+        uint32_t polls = 0;
+        uint32_t failures = 0;
+        uint64_t fetchTimeSum = 0;  // Over successful polls
+    };
+    std::vector<HostPollStats> pcMetricsHostStats_;  // Sized to the max host count
+    uint32_t pcMetricsPushCount_;                     // Pushed updates applied
+    uint64_t pcMetricsPushBytes_;                     // Total size of their bodies
+
+    std::vector<ScreenDrawTime> screenDrawTimes_;  // Circular buffer for screen draw times
     size_t screenDrawCapacity_;              // capacity (from config)
     size_t screenDrawIndex_;                 // Current index in the circular buffer
     size_t screenDrawCount_;                 // Number of valid entries in the buffer
+    uint32_t screenWakeupsNotified_;
+    uint32_t screenWakeupsTimed_;
+    uint32_t screenDamageFrames_;            // Frames that had anything to draw
+    uint64_t screenReportedPixels_;          // Total damage reported by widgets
+    uint64_t screenFlushedPixels_;           // Total damage after merging
+    uint32_t screenLastFlushedPixels_;
+    uint32_t screenMaxFlushedPixels_;
+    uint32_t screenSpriteCount_;
+    uint32_t screenSpriteBytes_;
+    uint32_t screenDirectWidgets_;
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "HeapWatch.h"
+
+#include <esp_heap_caps.h>
+
+#include <atomic>
+
+#ifndef NATIVE_BUILD
+#include <esp_idf_version.h>
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+#define HEAP_WATCH_LOCAL_MONITOR 1
+#endif
+#endif
+
+namespace {
+constexpr uint32_t HEAP_CAPS = MALLOC_CAP_INTERNAL;
+
+#ifdef HEAP_WATCH_LOCAL_MONITOR
+// The allocator has one restartable watermark, watches on other tasks fall back
+std::atomic<bool> monitorTaken{false};
+#endif
+}  // namespace
+
+void HeapWatch::begin() {
+    baseline_ = heap_caps_get_free_size(HEAP_CAPS);
+    lowWater_ = baseline_;
+    bootMinimum_ = heap_caps_get_minimum_free_size(HEAP_CAPS);
+#ifdef HEAP_WATCH_LOCAL_MONITOR
+    if (!localMonitor_ && !monitorTaken.exchange(true)) {
+        localMonitor_ = heap_caps_monitor_local_minimum_free_size_start() == ESP_OK;
+        if (!localMonitor_) {
+            monitorTaken = false;
+        }
+    }
+#endif
+}
+
+void HeapWatch::sample() {
+    uint32_t freeHeap = heap_caps_get_free_size(HEAP_CAPS);
+    if (freeHeap < lowWater_) {
+        lowWater_ = freeHeap;
+    }
+}
+
+uint32_t HeapWatch::end() {
+    sample();
+    uint32_t low = lowWater_;
+    uint32_t minimum = heap_caps_get_minimum_free_size(HEAP_CAPS);
+#ifdef HEAP_WATCH_LOCAL_MONITOR
+    if (localMonitor_) {
+        heap_caps_monitor_local_minimum_free_size_stop();
+        monitorTaken = false;
+        localMonitor_ = false;
+        low = minimum;
+    }
+#endif
+    // A new low since boot was set during the stretch
+    if (minimum < bootMinimum_ && minimum < low) {
+        low = minimum;
+    }
+    return baseline_ > low ? baseline_ - low : 0;
+}
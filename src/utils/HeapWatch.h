@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Peak internal heap use over a stretch of code, read from the allocator's
+ * minimum free watermark rather than from occasional samples.
+ *
+ * ESP-IDF 5.1 and later restart the watermark at begin(), so the peak is
+ * exact. Older releases only keep the minimum since boot: it pins the peak
+ * when the stretch set a new low, otherwise the lowest sample() reading
+ * stands in.
+ */
+class HeapWatch {
+ public:
+    void begin();
+    void sample();
+    // Bytes below the free heap at begin() at the lowest point since
+    uint32_t end();
+
+ private:
+    uint32_t baseline_ = 0;
+    uint32_t lowWater_ = 0;      // Lowest sample()
+    uint32_t bootMinimum_ = 0;   // Watermark since boot at begin()
+    bool localMonitor_ = false;  // Watermark restarted at begin()
+};
@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+"""Generate Libre Hardware Monitor data.json fixtures for the parse benchmark.
+
+The trees follow the layout LHM 0.9 serves (every node with id, Text, Min,
+Value, Max, ImageURL and Children; sensors also with SensorId and Type), for
+a few machine profiles. Values are random but seeded, so regenerating gives
+the same files. Only the standard library is used.
+
+    python3 tools/lhm_fixture.py src/native/bench/fixtures
+    python3 tools/lhm_fixture.py --profile workstation out/
+"""
+
+import argparse
+import json
+import os
+import random
+
+UNITS = {
+    "Voltage": "V", "Clock": "MHz", "Temperature": "°C", "Load": "%", "Fan": "RPM",
+    "Control": "%", "Power": "W", "Data": "GB", "SmallData": "MB", "Throughput": "KB/s",
+}
+
+SECTIONS = {
+    "Voltage": "Voltages", "Clock": "Clocks", "Temperature": "Temperatures", "Load": "Load",
+    "Fan": "Fans", "Control": "Controls", "Power": "Powers", "Data": "Data",
+    "SmallData": "Data", "Throughput": "Throughput",
+}
+
+ICONS = {
+    "Motherboard": "mainboard", "SuperIO": "chip", "Cpu": "cpu", "Memory": "ram",
+    "GpuNvidia": "nvidia", "GpuAmd": "ati", "Storage": "hdd", "Network": "nic",
+}
+
+
+class Tree:
+    """Builds nodes with consecutive ids, the way LHM numbers them"""
+
+    def __init__(self, seed):
+        self.next_id = 0
+        self.random = random.Random(seed)
+
+    def node(self, text, image, children=None):
+        node = {"id": self.next_id, "Text": text, "Min": "", "Value": "", "Max": "",
+                "ImageURL": image, "Children": children or []}
+        self.next_id += 1
+        return node
+
+    def hardware(self, text, kind, path, sections):
+        node = self.node(text, "images_icon/%s.png" % ICONS[kind])
+        node["HardwareId"] = path
+        node["Children"] = [self.section(path, sensor_type, sensors)
+                            for sensor_type, sensors in sections]
+        return node
+
+    def section(self, path, sensor_type, sensors):
+        node = self.node(SECTIONS[sensor_type], "images_icon/%s.png" % sensor_type.lower())
+        for index, (text, low, high) in enumerate(sensors):
+            node["Children"].append(self.sensor(path, sensor_type, index, text, low, high))
+        return node
+
+    def sensor(self, path, sensor_type, index, text, low, high):
+        value = self.random.uniform(low, high)
+        minimum = self.random.uniform(low, value)
+        maximum = self.random.uniform(value, high)
+        unit = UNITS[sensor_type]
+        digits = 0 if unit == "RPM" else (3 if unit == "V" else 1)
+        node = self.node(text, "images/transparent.png")
+        node.update({
+            "Min": "%.*f %s" % (digits, minimum, unit),
+            "Value": "%.*f %s" % (digits, value, unit),
+            "Max": "%.*f %s" % (digits, maximum, unit),
+            "SensorId": "%s/%s/%d" % (path, sensor_type.lower(), index),
+            "Type": sensor_type,
+        })
+        return node
+
+
+def motherboard(tree, board, chip, fans):
+    node = tree.node(board, "images_icon/mainboard.png")
+    node["HardwareId"] = "/motherboard"
+    sections = [
+        ("Voltage", [("Vcore", 0.9, 1.4), ("+3.3V", 3.2, 3.4), ("+5V", 4.9, 5.1),
+                     ("+12V", 11.8, 12.2), ("VBAT", 3.0, 3.3), ("VTT", 0.9, 1.1)]),
+        ("Temperature", [("CPU", 35, 80), ("Motherboard", 28, 45), ("PCH", 40, 60),
+                         ("Auxiliary", 25, 40)]),
+        ("Fan", [("CPU Fan", 600, 1800)] +
+                [("System Fan #%d" % i, 400, 1400) for i in range(1, fans + 1)]),
+        ("Control", [("CPU Fan", 20, 100)] +
+                    [("System Fan #%d" % i, 20, 100) for i in range(1, fans + 1)]),
+    ]
+    node["Children"] = [tree.hardware(chip, "SuperIO", "/lpc/nct6798d", sections)]
+    return node
+
+
+def cpu(tree, name, path, cores, smt):
+    threads = [("CPU Core #%d Thread #%d" % (core, thread), 0, 100)
+               for core in range(1, cores + 1) for thread in range(1, 3 if smt else 2)]
+    if not smt:
+        threads = [("CPU Core #%d" % core, 0, 100) for core in range(1, cores + 1)]
+    return tree.hardware(name, "Cpu", path, [
+        ("Voltage", [("CPU Core", 0.9, 1.4)] +
+                    [("CPU Core #%d" % core, 0.9, 1.4) for core in range(1, cores + 1)]),
+        ("Clock", [("Bus Speed", 99, 101)] +
+                  [("CPU Core #%d" % core, 3000, 5200) for core in range(1, cores + 1)]),
+        ("Temperature", [("Core (Tctl/Tdie)", 35, 85), ("CPU Package", 35, 85)] +
+                        [("CPU Core #%d" % core, 35, 85) for core in range(1, cores + 1)]),
+        ("Load", [("CPU Total", 0, 100), ("CPU Core Max", 0, 100)] + threads),
+        ("Power", [("CPU Package", 20, 280), ("CPU Cores", 10, 200)] +
+                  [("CPU Core #%d" % core, 1, 20) for core in range(1, cores + 1)]),
+    ])
+
+
+def memory(tree):
+    return tree.hardware("Generic Memory", "Memory", "/ram", [
+        ("Load", [("Memory", 20, 80), ("Virtual Memory", 20, 80)]),
+        ("Data", [("Memory Used", 4, 24), ("Memory Available", 4, 24),
+                  ("Virtual Memory Used", 6, 30), ("Virtual Memory Available", 6, 30)]),
+    ])
+
+
+def gpu(tree, name, kind, path, memory_mb):
+    return tree.hardware(name, kind, path, [
+        ("Voltage", [("GPU Core", 0.7, 1.1)]),
+        ("Clock", [("GPU Core", 300, 2600), ("GPU Memory", 400, 10500)]),
+        ("Temperature", [("GPU Core", 30, 80), ("GPU Hot Spot", 35, 95)]),
+        ("Load", [("GPU Core", 0, 100), ("GPU Memory Controller", 0, 100),
+                  ("GPU Video Engine", 0, 100), ("GPU Memory", 0, 100), ("D3D 3D", 0, 100),
+                  ("D3D Copy", 0, 100), ("D3D Video Decode", 0, 100),
+                  ("D3D Compute_0", 0, 100), ("D3D Compute_1", 0, 100)]),
+        ("Fan", [("GPU Fan 1", 0, 2400), ("GPU Fan 2", 0, 2400)]),
+        ("Power", [("GPU Package", 10, 450)]),
+        ("SmallData", [("GPU Memory Free", 256, memory_mb), ("GPU Memory Used", 256, memory_mb),
+                       ("GPU Memory Total", memory_mb, memory_mb),
+                       ("D3D Dedicated Memory Used", 256, memory_mb),
+                       ("D3D Shared Memory Used", 0, 512)]),
+        ("Throughput", [("GPU PCIe Rx", 0, 20000), ("GPU PCIe Tx", 0, 20000)]),
+    ])
+
+
+def storage(tree, name, index):
+    return tree.hardware(name, "Storage", "/nvme/%d" % index, [
+        ("Temperature", [("Temperature", 30, 60), ("Temperature 2", 30, 70)]),
+        ("Load", [("Used Space", 10, 90), ("Read Activity", 0, 100),
+                  ("Write Activity", 0, 100), ("Total Activity", 0, 100)]),
+        ("Data", [("Data Read", 100, 90000), ("Data Written", 100, 90000)]),
+        ("Throughput", [("Read Rate", 0, 3000000), ("Write Rate", 0, 3000000)]),
+    ])
+
+
+def network(tree, name, index):
+    return tree.hardware(name, "Network", "/nic/%d" % index, [
+        ("Data", [("Data Uploaded", 0, 100), ("Data Downloaded", 0, 500)]),
+        ("Throughput", [("Upload Speed", 0, 12000), ("Download Speed", 0, 120000)]),
+        ("Load", [("Network Utilization", 0, 100)]),
+    ])
+
+
+def small_desktop(tree):
+    return "DESKTOP-SMALL", [
+        motherboard(tree, "MSI PRO B660M-A", "Nuvoton NCT6687D", 2),
+        cpu(tree, "Intel Core i3-12100", "/intelcpu/0", 4, True),
+        memory(tree),
+        gpu(tree, "NVIDIA GeForce GTX 1660 SUPER", "GpuNvidia", "/gpu-nvidia/0", 6144),
+        storage(tree, "Samsung SSD 980 500GB", 0),
+        network(tree, "Ethernet", 0),
+    ]
+
+
+def workstation(tree):
+    return "WORKSTATION", [
+        motherboard(tree, "ASUS Pro WS WRX80E-SAGE SE WIFI", "Nuvoton NCT6798D", 6),
+        cpu(tree, "AMD Ryzen Threadripper PRO 5975WX", "/amdcpu/0", 32, False),
+        memory(tree),
+        gpu(tree, "NVIDIA RTX A4000", "GpuNvidia", "/gpu-nvidia/0", 16384),
+    ] + [storage(tree, "Samsung SSD 990 PRO 2TB", i) for i in range(4)] + [
+        network(tree, name, i)
+        for i, name in enumerate(["Ethernet", "Ethernet 2", "Wi-Fi", "Bluetooth"])
+    ]
+
+
+def multi_gpu(tree):
+    return "DESKTOP-MULTIGPU", [
+        motherboard(tree, "ASUS ROG STRIX X670E-E GAMING WIFI", "Nuvoton NCT6799D", 5),
+        cpu(tree, "AMD Ryzen 9 7950X", "/amdcpu/0", 16, True),
+        memory(tree),
+        gpu(tree, "AMD Radeon(TM) Graphics", "GpuAmd", "/gpu-amd/0", 512),
+        gpu(tree, "NVIDIA GeForce RTX 4090", "GpuNvidia", "/gpu-nvidia/0", 24564),
+        gpu(tree, "NVIDIA GeForce RTX 3060", "GpuNvidia", "/gpu-nvidia/1", 12288),
+        storage(tree, "Samsung SSD 990 PRO 2TB", 0),
+        storage(tree, "WD_BLACK SN850X 4000GB", 1),
+        network(tree, "Ethernet", 0),
+        network(tree, "Wi-Fi", 1),
+    ]
+
+
+def gpu_server(tree):
+    # Many near-identical sections, the worst case for searching sensors by Text
+    return "GPU-SERVER", [
+        motherboard(tree, "Supermicro X13DEG-OAD", "Nuvoton NCT6796D", 8),
+        cpu(tree, "Intel Xeon Gold 6448Y", "/intelcpu/0", 32, True),
+        cpu(tree, "Intel Xeon Gold 6448Y", "/intelcpu/1", 32, True),
+        memory(tree),
+    ] + [gpu(tree, "NVIDIA RTX 6000 Ada Generation", "GpuNvidia", "/gpu-nvidia/%d" % i, 49140)
+         for i in range(8)] + [
+        storage(tree, "Micron 7450 PRO 3840GB", i) for i in range(6)
+    ] + [network(tree, name, i) for i, name in enumerate(["Ethernet", "Ethernet 2"])]
+
+
+PROFILES = {
+    "small_desktop": small_desktop,
+    "workstation": workstation,
+    "multi_gpu": multi_gpu,
+    "gpu_server": gpu_server,
+}
+
+
+def generate(profile):
+    tree = Tree(seed=profile)
+    root = tree.node("Sensor", "")
+    computer = tree.node("", "images_icon/computer.png")
+    computer["Text"], computer["Children"] = PROFILES[profile](tree)
+    root["Children"] = [computer]
+    return root
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("directory", help="where to write <profile>.json")
+    parser.add_argument("--profile", choices=sorted(PROFILES), action="append",
+                        help="profile to generate (default all)")
+    args = parser.parse_args()
+
+    os.makedirs(args.directory, exist_ok=True)
+    for profile in args.profile or sorted(PROFILES):
+        path = os.path.join(args.directory, profile + ".json")
+        with open(path, "w", encoding="utf-8") as out:
+            # LHM serves compact JSON with non-ASCII characters as-is
+            json.dump(generate(profile), out, ensure_ascii=False, separators=(",", ":"))
+        print("%s: %d bytes" % (path, os.path.getsize(path)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Serve Libre Hardware Monitor data.json as MessagePack.
+
+Runs on the PC next to LHM. Point LIBRE_HM_API at this proxy instead of LHM;
+requests that accept application/msgpack get a MessagePack body, others get
+JSON. Either way the tree is trimmed to the Text, Value and Children fields
+the display reads, and value strings such as "45.0 %" are sent as floats.
+Data sizes are normalized to MB, the unit the firmware assumes for bare
+numbers. Only the standard library is used.
+
+    python3 tools/lhm_msgpack_proxy.py --lhm http://localhost:8085/data.json --port 8086
+    python3 tools/lhm_msgpack_proxy.py --compare recorded/data.json
+"""
+
+import argparse
+import http.server
+import json
+import struct
+import sys
+import urllib.request
+
+UNIT_SCALE = {"GB": 1024.0, "KB": 1.0 / 1024.0}
+
+
+def parse_value(text):
+    """'45.0 %' -> 45.0, '1,2 GB' -> 1228.8; None if text has no number"""
+    parts = text.replace(",", ".").split(" ")
+    try:
+        number = float(parts[0])
+    except ValueError:
+        return None
+    unit = parts[1] if len(parts) > 1 else ""
+    return number * UNIT_SCALE.get(unit, 1.0)
+
+
+def trim(node):
+    out = {"Text": node.get("Text", "")}
+    value = parse_value(node.get("Value", ""))
+    if value is not None:
+        out["Value"] = value
+    children = node.get("Children")
+    if children:
+        out["Children"] = [trim(child) for child in children]
+    return out
+
+
+def pack(obj, out):
+    """Minimal MessagePack encoder for the types trim() produces"""
+    if obj is None:
+        out.append(0xC0)
+    elif isinstance(obj, bool):
+        out.append(0xC3 if obj else 0xC2)
+    elif isinstance(obj, int) and 0 <= obj < 0x80:
+        out.append(obj)
+    elif isinstance(obj, (int, float)):
+        out += b"\xca" + struct.pack(">f", obj)
+    elif isinstance(obj, str):
+        data = obj.encode()
+        if len(data) < 32:
+            out.append(0xA0 | len(data))
+        elif len(data) < 0x100:
+            out += bytes([0xD9, len(data)])
+        else:
+            out += b"\xda" + struct.pack(">H", len(data))
+        out += data
+    elif isinstance(obj, list):
+        out += bytes([0x90 | len(obj)]) if len(obj) < 16 else b"\xdc" + struct.pack(">H", len(obj))
+        for item in obj:
+            pack(item, out)
+    elif isinstance(obj, dict):
+        out += bytes([0x80 | len(obj)]) if len(obj) < 16 else b"\xde" + struct.pack(">H", len(obj))
+        for key, value in obj.items():
+            pack(key, out)
+            pack(value, out)
+    else:
+        raise TypeError("cannot pack %r" % type(obj))
+    return out
+
+
+def encode(tree, msgpack):
+    trimmed = trim(tree)
+    if msgpack:
+        return bytes(pack(trimmed, bytearray())), "application/msgpack"
+    return json.dumps(trimmed, separators=(",", ":")).encode(), "application/json"
+
+
+def compare(path):
+    with open(path, "rb") as f:
+        raw = f.read()
+    tree = json.loads(raw)
+    trimmed_json, _ = encode(tree, False)
+    trimmed_msgpack, _ = encode(tree, True)
+    print("%-24s %8d bytes" % ("LHM data.json", len(raw)))
+    print("%-24s %8d bytes" % ("trimmed JSON", len(trimmed_json)))
+    print("%-24s %8d bytes" % ("trimmed MessagePack", len(trimmed_msgpack)))
+
+
+def serve(lhm_url, port):
+    class Handler(http.server.BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"  # Lets the display keep the connection open
+
+        def do_GET(self):
+            try:
+                with urllib.request.urlopen(lhm_url, timeout=2) as response:
+                    tree = json.load(response)
+            except (OSError, ValueError) as error:
+                self.send_error(502, str(error))
+                return
+            msgpack = "msgpack" in self.headers.get("Accept", "")
+            body, content_type = encode(tree, msgpack)
+            self.send_response(200)
+            self.send_header("Content-Type", content_type)
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+    server = http.server.ThreadingHTTPServer(("", port), Handler)
+    print("proxying %s on port %d" % (lhm_url, port))
+    server.serve_forever()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--lhm", default="http://localhost:8085/data.json",
+                        help="Libre Hardware Monitor data.json URL")
+    parser.add_argument("--port", type=int, default=8086, help="port to serve on")
+    parser.add_argument("--compare", metavar="FILE",
+                        help="print payload sizes for a recorded data.json and exit")
+    args = parser.parse_args()
+
+    if args.compare:
+        compare(args.compare)
+        return 0
+    serve(args.lhm, args.port)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
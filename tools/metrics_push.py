@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+"""Push PC metrics to a NerdBox display.
+
+Sends id=value lines to POST /metrics/push. Values come either from a local
+Libre Hardware Monitor data.json (--lhm) or from a random walk (--fake) for
+testing without LHM. Only the standard library is used.
+
+    python3 tools/metrics_push.py --device 192.168.1.50 --fake
+    python3 tools/metrics_push.py --device 192.168.1.50 --lhm http://localhost:8085/data.json
+"""
+
+import argparse
+import json
+import random
+import sys
+import time
+import urllib.error
+import urllib.request
+
+MAX_THREADS = 64
+
+
+def walk(value, low, high, step):
+    return min(high, max(low, value + random.uniform(-step, step)))
+
+
+class FakeSource:
+    """Random walk over every pushed id"""
+
+    def __init__(self, threads):
+        self.values = {
+            "cpu": 20.0, "cpu_w": 60.0, "cpu_c": 45.0,
+            "fan_cpu": 900.0, "fan_f": 700.0, "fan_b": 700.0,
+            "gpu_3d": 10.0, "gpu_cmp": 5.0, "gpu_mem": 4096.0, "gpu_mem_total": 16384.0,
+            "mem": 40.0,
+        }
+        for i in range(threads):
+            self.values["t%d" % i] = 10.0
+
+    def read(self):
+        limits = {"cpu_w": (5, 250), "cpu_c": (30, 95), "fan_cpu": (400, 2000),
+                  "fan_f": (400, 1500), "fan_b": (400, 1500), "gpu_mem": (500, 16000),
+                  "gpu_mem_total": (16384, 16384)}
+        for key, value in self.values.items():
+            low, high = limits.get(key, (0, 100))
+            self.values[key] = walk(value, low, high, (high - low) * 0.05)
+        return dict(self.values)
+
+
+class LhmSource:
+    """Reads the same sensors the firmware picks out of data.json"""
+
+    def __init__(self, url):
+        self.url = url
+
+    def read(self):
+        with urllib.request.urlopen(self.url, timeout=2) as response:
+            tree = json.load(response)
+        values = {}
+        for hardware in tree["Children"][0]["Children"]:
+            self.read_hardware(hardware, hardware.get("Text", ""), values)
+        return values
+
+    def read_hardware(self, node, hardware, values):
+        for child in node.get("Children", []):
+            if "Value" in child and not child.get("Children"):
+                self.map_sensor(hardware, child["Text"], child["Value"], values)
+            else:
+                self.read_hardware(child, hardware, values)
+
+    @staticmethod
+    def map_sensor(hardware, text, value, values):
+        number = parse_number(value)
+        if number is None:
+            return
+        if "Intel Core" in hardware or "AMD Ryzen" in hardware:
+            if text == "CPU Total":
+                values.setdefault("cpu", number)
+            elif text == "CPU Package" and value.endswith("W"):
+                values.setdefault("cpu_w", number)
+            elif text in ("CPU Package", "Core (Tctl/Tdie)") and "C" in value:
+                values.setdefault("cpu_c", number)
+            elif text.startswith("CPU Core #") and value.endswith("%"):
+                index = sum(1 for key in values if key.startswith("t"))
+                if index < MAX_THREADS:
+                    values["t%d" % index] = number
+        elif "NVIDIA" in hardware or "AMD Radeon" in hardware:
+            if text in ("GPU Core", "D3D 3D"):
+                values.setdefault("gpu_3d", number)
+            elif text in ("Compute", "D3D Compute_0"):
+                values.setdefault("gpu_cmp", number)
+            elif text == "GPU Memory Used":
+                values.setdefault("gpu_mem", number * (1024 if value.endswith("GB") else 1))
+            elif text == "GPU Memory Total":
+                values.setdefault("gpu_mem_total", number * (1024 if value.endswith("GB") else 1))
+        elif "Memory" in hardware:
+            if text == "Memory" and value.endswith("%"):
+                values.setdefault("mem", number)
+
+
+def parse_number(value):
+    text = value.split(" ")[0].replace(",", ".")
+    try:
+        return float(text)
+    except ValueError:
+        return None
+
+
+def encode(values, previous, changed_only):
+    lines = []
+    for key, value in values.items():
+        # Thread loads always go out whole, the device takes the thread count from each push
+        unchanged = previous.get(key) is not None and round(previous[key], 1) == round(value, 1)
+        thread_load = key.startswith("t") and key[1:].isdigit()
+        if changed_only and unchanged and not thread_load:
+            continue
+        lines.append("%s=%.1f" % (key, value))
+    return "\n".join(lines).encode()
+
+
+def push(device, host, body):
+    url = "http://%s/metrics/push?host=%d" % (device, host)
+    request = urllib.request.Request(url, data=body, method="POST",
+                                     headers={"Content-Type": "text/plain"})
+    with urllib.request.urlopen(request, timeout=2) as response:
+        return response.status
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--device", required=True, help="NerdBox address, e.g. 192.168.1.50")
+    parser.add_argument("--host", type=int, default=0, help="host slot to update (default 0)")
+    parser.add_argument("--interval", type=float, default=1.0, help="seconds between pushes")
+    parser.add_argument("--threads", type=int, default=20,
+                        help="thread loads to fake (default 20, at most %d)" % MAX_THREADS)
+    parser.add_argument("--changed-only", action="store_true",
+                        help="send only values that changed since the last push")
+    source_group = parser.add_mutually_exclusive_group(required=True)
+    source_group.add_argument("--fake", action="store_true", help="send random-walk values")
+    source_group.add_argument("--lhm", metavar="URL", help="Libre Hardware Monitor data.json")
+    args = parser.parse_args()
+
+    source = FakeSource(min(args.threads, MAX_THREADS)) if args.fake else LhmSource(args.lhm)
+    previous = {}
+    while True:
+        started = time.monotonic()
+        try:
+            values = source.read()
+            body = encode(values, previous, args.changed_only)
+            if body:
+                push(args.device, args.host, body)
+            previous = values
+            print("pushed %d bytes" % len(body))
+        except (urllib.error.URLError, OSError, ValueError, KeyError) as error:
+            print("push failed: %s" % error, file=sys.stderr)
+            previous = {}  # resend everything once the device is back
+        time.sleep(max(0.0, args.interval - (time.monotonic() - started)))
+
+
+if __name__ == "__main__":
+    main()
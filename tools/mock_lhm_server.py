@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Serve a Libre Hardware Monitor data.json for the native build.
+
+Every request returns the fixture with its sensor values moved a little, so
+the display keeps redrawing. Keep-alive and Content-Length behave like LHM;
+--chunked and --latency-ms exercise the slower paths. Only the standard
+library is used.
+
+    python3 tools/mock_lhm_server.py
+    python3 tools/mock_lhm_server.py --fixture src/native/bench/fixtures/workstation.json
+    python3 tools/mock_lhm_server.py --ports 8085 8086 --latency-ms 40
+"""
+
+import argparse
+import http.server
+import json
+import os
+import random
+import re
+import threading
+import time
+
+DEFAULT_FIXTURE = os.path.join(os.path.dirname(__file__), "..", "src", "native", "bench",
+                               "fixtures", "small_desktop.json")
+
+NUMBER = re.compile(r"^(-?\d+(?:[.,]\d+)?)(.*)$")
+
+
+class SensorTree:
+    """The fixture, with a random walk applied to every numeric Value"""
+
+    def __init__(self, path):
+        with open(path, encoding="utf-8") as source:
+            self.tree = json.load(source)
+        self.lock = threading.Lock()
+
+    def step(self):
+        with self.lock:
+            self.walk(self.tree)
+            return json.dumps(self.tree, ensure_ascii=False, separators=(",", ":")).encode()
+
+    def walk(self, node):
+        match = NUMBER.match(node.get("Value", ""))
+        if match and not node.get("Children"):
+            number = float(match.group(1).replace(",", "."))
+            digits = len(match.group(1).partition(".")[2])
+            step = max(abs(number) * 0.05, 1.0)
+            number = max(0.0, number + random.uniform(-step, step))
+            if match.group(2).strip() == "%":
+                number = min(number, 100.0)
+            node["Value"] = "%.*f%s" % (digits, number, match.group(2))
+        for child in node.get("Children", []):
+            self.walk(child)
+
+
+def make_handler(tree, latency_ms, chunked):
+    class Handler(http.server.BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"  # Keep-alive, as LHM
+
+        def do_GET(self):
+            if self.path.split("?")[0] != "/data.json":
+                self.send_error(404)
+                return
+            body = tree.step()
+            if latency_ms:
+                time.sleep(latency_ms / 1000.0)
+
+            self.send_response(200)
+            self.send_header("Content-Type", "application/json")
+            if chunked and self.request_version == "HTTP/1.1":
+                self.send_header("Transfer-Encoding", "chunked")
+                self.end_headers()
+                for start in range(0, len(body), 4096):
+                    chunk = body[start:start + 4096]
+                    self.wfile.write(b"%x\r\n%s\r\n" % (len(chunk), chunk))
+                self.wfile.write(b"0\r\n\r\n")
+            else:
+                self.send_header("Content-Length", str(len(body)))
+                self.end_headers()
+                self.wfile.write(body)
+
+        def log_message(self, format, *args):
+            pass  # One line per poll would drown the output
+
+    return Handler
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--fixture", default=DEFAULT_FIXTURE, help="data.json to serve")
+    parser.add_argument("--ports", type=int, nargs="+", default=[8085],
+                        help="one simulated host per port (default 8085)")
+    parser.add_argument("--latency-ms", type=int, default=0,
+                        help="delay before every response")
+    parser.add_argument("--chunked", action="store_true",
+                        help="send chunked bodies instead of Content-Length")
+    args = parser.parse_args()
+
+    servers = []
+    for port in args.ports:
+        handler = make_handler(SensorTree(args.fixture), args.latency_ms, args.chunked)
+        server = http.server.ThreadingHTTPServer(("127.0.0.1", port), handler)
+        threading.Thread(target=server.serve_forever, daemon=True).start()
+        servers.append(server)
+        print("serving %s on http://127.0.0.1:%d/data.json" % (args.fixture, port))
+
+    try:
+        threading.Event().wait()
+    except KeyboardInterrupt:
+        for server in servers:
+            server.shutdown()
+
+
+if __name__ == "__main__":
+    main()